@@ -30,6 +30,7 @@ int main() {
 
     // 3. Setup Formatter
     LogFormatter<CpuPolicy> cpuFormatter("Desktop-Linux", "CPU_LOAD");
+    cpuFormatter.bindFilter(manager.getSeverityFilter());
     
     UI::info("System active. Enter CPU percentages (e.g., 45.5) or type 'exit' to quit.");
     UI::alert("Notice: Logging is now happening on a separate background thread!");
@@ -42,12 +43,13 @@ int main() {
         }
 
         // 4. Producer Logic: Format and push to RingBuffer
-        auto logMsg = cpuFormatter.formatDataToLogMsg(input);
+        LogMessage logMsg;
+        FormatStatus_enum status = cpuFormatter.tryFormat(input, logMsg);
         
-        if (logMsg) {
+        if (status == FormatStatus_enum::ACCEPTED) {
             // manager.addLog now notifies the background thread immediately
-            manager.addLog(std::move(*logMsg));
-        } else {
+            manager.addLog(std::move(logMsg));
+        } else if (status == FormatStatus_enum::REJECTED) {
             UI::alert("Invalid data input. Format logic rejected value: " + input);
         }
     }
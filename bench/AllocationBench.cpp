@@ -0,0 +1,125 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "BenchCases.hpp"
+#include "logger/LogManager.hpp"
+#include "formatter/LogFormatter.hpp"
+#include "formatter/policies/CpuPolicy.hpp"
+
+// Counts heap allocations made anywhere in the process while messages flow
+// through LogManager in steady state (after a warm-up run), plus RSS before
+// and after. The replacement operator new below applies to the whole
+// TeleLogBench binary; the extra relaxed increment does not affect the
+// other cases measurably.
+
+namespace {
+    std::atomic<uint64_t> allocationCount{0};
+}
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+    constexpr size_t MESSAGE_COUNT = 2'000'000;
+    constexpr size_t CHUNK = 1000;
+
+    class NullSink : public ILogSink {
+    public:
+        void write(const LogMessage&) override {}
+        void writeBatch(const std::vector<LogMessage>&) override {}
+    };
+
+    size_t residentBytes() {
+        long pages = 0;
+        long resident = 0;
+        if (FILE* statm = std::fopen("/proc/self/statm", "r")) {
+            if (std::fscanf(statm, "%ld %ld", &pages, &resident) != 2) {
+                resident = 0;
+            }
+            std::fclose(statm);
+        }
+        return static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    // Pushes count messages in chunks, letting the consumer keep up so
+    // nothing is dropped and every batch reaches the sinks
+    void pump(LogManager& manager, const LogMessage& sample, size_t count) {
+        for (size_t sent = 0; sent < count; sent += CHUNK) {
+            for (size_t i = 0; i < CHUNK; ++i) {
+                LogMessage msg = sample;
+                manager.addLog(std::move(msg));
+            }
+            while (manager.getQueueDepth() > 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void runScenario(BenchReport& report, const char* variant, size_t asyncSinks, size_t count) {
+        LogFormatter<CpuPolicy> formatter("Bench", "CPU_LOAD");
+        LogMessage sample = *formatter.formatDataToLogMsg("42.0");
+
+        LogManagerConfig config;
+        config.capacity = 8192;
+        LogManager manager(config);
+        manager.addSink(std::make_unique<NullSink>());
+        for (size_t i = 0; i < asyncSinks; ++i) {
+            manager.addSink(std::make_unique<NullSink>(), SinkDispatch_enum::ASYNC);
+        }
+
+        pump(manager, sample, count / 4);   // Warm-up: pools, reserves, thread_locals
+
+        size_t rssBefore = residentBytes();
+        uint64_t before = allocationCount.load(std::memory_order_relaxed);
+        pump(manager, sample, count);
+        uint64_t allocations = allocationCount.load(std::memory_order_relaxed) - before;
+        size_t rssAfter = residentBytes();
+
+        const std::string param = "messages=" + std::to_string(count);
+        report.add({"allocations", variant, param, "steady_state_allocations", static_cast<double>(allocations), "allocs"});
+        report.add({"allocations", variant, param, "rss_growth",
+                    static_cast<double>(rssAfter > rssBefore ? rssAfter - rssBefore : 0) / 1024.0, "KiB"});
+        report.add({"allocations", variant, param, "rss", static_cast<double>(rssAfter) / 1024.0, "KiB"});
+
+        LogManagerMetrics metrics = manager.getMetrics();
+        report.add({"allocations", variant, param, "batch_pool_slots", static_cast<double>(metrics.batchPoolSlots), "slots"});
+    }
+}
+
+void benchAllocations(BenchReport& report, const BenchOptions& options) {
+    const size_t count = MESSAGE_COUNT / options.scale;
+    runScenario(report, "inline-sink", 0, count);
+    runScenario(report, "inline+2-async-sinks", 2, count);
+}
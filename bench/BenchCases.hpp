@@ -0,0 +1,14 @@
+#pragma once
+#include "BenchReport.hpp"
+
+// Each case appends its rows to the report
+void benchRingBuffer(BenchReport& report, const BenchOptions& options);
+void benchAddLogLatency(BenchReport& report, const BenchOptions& options);
+void benchFormatter(BenchReport& report, const BenchOptions& options);
+void benchRender(BenchReport& report, const BenchOptions& options);
+void benchFileSink(BenchReport& report, const BenchOptions& options);
+void benchLineReader(BenchReport& report, const BenchOptions& options);
+void benchAllocations(BenchReport& report, const BenchOptions& options);
+void benchWakeup(BenchReport& report, const BenchOptions& options);
+void benchSampling(BenchReport& report, const BenchOptions& options);
+void benchSharded(BenchReport& report, const BenchOptions& options);
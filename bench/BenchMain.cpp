@@ -0,0 +1,93 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "BenchCases.hpp"
+
+// TeleLogBench: self-contained micro-benchmarks for the logging pipeline.
+//
+//   TeleLogBench [--format csv|json] [--output FILE] [--filter NAME]
+//                [--quick] [--max-producers N]
+//
+// Results go to stdout (or FILE) as CSV or JSON; progress goes to stderr.
+
+namespace {
+    struct BenchCase {
+        const char* name;
+        std::function<void(BenchReport&, const BenchOptions&)> run;
+    };
+
+    void usage() {
+        std::cerr << "usage: TeleLogBench [--format csv|json] [--output FILE] [--filter NAME] "
+                     "[--quick] [--max-producers N]\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    std::string format = "csv";
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--format" && hasValue) {
+            format = argv[++i];
+        } else if (arg == "--output" && hasValue) {
+            outputPath = argv[++i];
+        } else if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--max-producers" && hasValue) {
+            options.maxProducers = static_cast<size_t>(std::atoi(argv[++i]));
+        } else if (arg == "--quick") {
+            options.scale = 10;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if ((format != "csv" && format != "json") || options.maxProducers == 0) {
+        usage();
+        return 1;
+    }
+
+    const std::vector<BenchCase> cases = {
+        {"ring_buffer", benchRingBuffer},
+        {"addlog_latency", benchAddLogLatency},
+        {"formatter", benchFormatter},
+        {"render", benchRender},
+        {"file_sink", benchFileSink},
+        {"line_reader", benchLineReader},
+        {"allocations", benchAllocations},
+        {"wakeup", benchWakeup},
+        {"sampling", benchSampling},
+        {"sharded", benchSharded},
+    };
+
+    BenchReport report;
+    for (const auto& benchCase : cases) {
+        if (options.filter.empty() || std::strstr(benchCase.name, options.filter.c_str()) != nullptr) {
+            benchCase.run(report, options);
+        }
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output: " << outputPath << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+    if (format == "json") {
+        report.writeJson(out);
+    } else {
+        report.writeCsv(out);
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "BenchReport.hpp"
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    void writeJsonString(std::ostream& os, const std::string& text) {
+        os << '"';
+        for (char ch : text) {
+            if (ch == '"' || ch == '\\') {
+                os << '\\';
+            }
+            os << ch;
+        }
+        os << '"';
+    }
+}
+
+void BenchReport::add(BenchResult result) {
+    // Echo progress for humans; the report itself goes to the chosen output
+    std::cerr << result.benchmark << " " << result.variant << " " << result.parameter << " "
+              << result.metric << " = " << result.value << " " << result.unit << "\n";
+    results.push_back(std::move(result));
+}
+
+void BenchReport::writeCsv(std::ostream& os) const {
+    os << "benchmark,variant,parameter,metric,value,unit\n";
+    os << std::setprecision(10);
+    for (const auto& r : results) {
+        os << r.benchmark << ',' << r.variant << ',' << r.parameter << ','
+           << r.metric << ',' << r.value << ',' << r.unit << '\n';
+    }
+}
+
+void BenchReport::writeJson(std::ostream& os) const {
+    os << "[\n" << std::setprecision(10);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        os << "  {\"benchmark\": ";
+        writeJsonString(os, r.benchmark);
+        os << ", \"variant\": ";
+        writeJsonString(os, r.variant);
+        os << ", \"parameter\": ";
+        writeJsonString(os, r.parameter);
+        os << ", \"metric\": ";
+        writeJsonString(os, r.metric);
+        os << ", \"value\": " << r.value << ", \"unit\": ";
+        writeJsonString(os, r.unit);
+        os << (i + 1 < results.size() ? "},\n" : "}\n");
+    }
+    os << "]\n";
+}
+
+double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[index < sorted.size() ? index : sorted.size() - 1];
+}
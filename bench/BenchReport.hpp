@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Machine-readable results of the TeleLogBench suite.
+// One row per measured value so CSV/JSON diffs between releases stay simple.
+struct BenchResult {
+    std::string benchmark;      // e.g. "ring_buffer"
+    std::string variant;        // e.g. "lockfree-mpsc"
+    std::string parameter;      // e.g. "producers=4"
+    std::string metric;         // e.g. "throughput"
+    double value;
+    std::string unit;           // e.g. "ops/s", "ns"
+};
+
+struct BenchOptions {
+    size_t scale = 1;           // Divides iteration counts (--quick uses 10)
+    size_t maxProducers = 16;
+    std::string filter;         // Substring of the benchmark name, empty = all
+};
+
+class BenchReport {
+private:
+    std::vector<BenchResult> results;
+
+public:
+    void add(BenchResult result);
+
+    void writeCsv(std::ostream& os) const;
+    void writeJson(std::ostream& os) const;
+};
+
+// Percentile over an already sorted sample, q in [0, 1]
+double percentile(const std::vector<double>& sorted, double q);
@@ -0,0 +1,72 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+#include "BenchCases.hpp"
+#include "sink/FileSinkImpl.hpp"
+#include "sink/MappedFileSinkImpl.hpp"
+#include "sink/BinarySinkImpl.hpp"
+#include "formatter/LogFormatter.hpp"
+#include "formatter/policies/CpuPolicy.hpp"
+
+// Sustained writeBatch throughput of the file-backed sinks, fed directly
+// with LogManager-sized batches.
+
+namespace {
+    constexpr size_t MESSAGE_COUNT = 2'000'000;
+    constexpr size_t BATCH_SIZE = 256;
+    const std::string BENCH_PATH = "/tmp/telelog_filesink_bench";
+
+    size_t fileSize(const std::string& path) {
+        struct stat info;
+        return stat(path.c_str(), &info) == 0 ? static_cast<size_t>(info.st_size) : 0;
+    }
+
+    void run(BenchReport& report, const char* variant, ILogSink& sink,
+             const std::vector<LogMessage>& batch, size_t batches) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < batches; ++i) {
+            sink.writeBatch(batch);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        const std::string param = "messages=" + std::to_string(batches * batch.size());
+        report.add({"file_sink", variant, param, "throughput",
+                    static_cast<double>(batches * batch.size()) / elapsed.count(), "msgs/s"});
+    }
+}
+
+void benchFileSink(BenchReport& report, const BenchOptions& options) {
+    LogFormatter<CpuPolicy> formatter("Bench", "CPU_LOAD");
+    std::vector<LogMessage> batch;
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        batch.push_back(*formatter.formatDataToLogMsg(std::to_string(i % 100)));
+    }
+    const size_t batches = MESSAGE_COUNT / options.scale / BATCH_SIZE;
+
+    {
+        std::remove(BENCH_PATH.c_str());
+        FileSink sink(BENCH_PATH, std::ios::trunc);
+        run(report, "FileSink", sink, batch, batches);
+    }
+    report.add({"file_sink", "FileSink", "", "bytes", static_cast<double>(fileSize(BENCH_PATH)), "bytes"});
+    std::remove(BENCH_PATH.c_str());
+
+    {
+        MappedFileSink sink(BENCH_PATH);
+        run(report, "MappedFileSink", sink, batch, batches);
+    }
+    for (size_t i = 0; std::remove((BENCH_PATH + "." + std::to_string(i)).c_str()) == 0; ++i) {
+    }
+
+    {
+        std::remove(BENCH_PATH.c_str());
+        BinarySink sink(BENCH_PATH);
+        run(report, "BinarySink", sink, batch, batches);
+    }
+    report.add({"file_sink", "BinarySink", "", "bytes", static_cast<double>(fileSize(BENCH_PATH)), "bytes"});
+    std::remove(BENCH_PATH.c_str());
+}
@@ -0,0 +1,102 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "BenchCases.hpp"
+#include "formatter/LogFormatter.hpp"
+#include "formatter/policies/CpuPolicy.hpp"
+#include "formatter/policies/RamPolicy.hpp"
+#include "formatter/policies/GpuPolicy.hpp"
+
+// Cost per reading of LogFormatter<Policy>::formatDataToLogMsg, of the former
+// std::stof + try/catch path, and of parseBatch, on clean input and on input
+// where every tenth line is garbage.
+
+namespace {
+    constexpr size_t SAMPLE_COUNT = 2'000'000;
+
+    // formatDataToLogMsg as it was before it went exception-free
+    template <typename Policy>
+    std::optional<LogMessage> legacyFormat(uint16_t app, uint16_t ctx, uint8_t policy, const std::string& rawData) {
+        try {
+            float value = std::stof(rawData);
+            return LogMessage(app, ctx, policy, mapToLogType(Policy::inferSeverity(value)), value,
+                              std::chrono::system_clock::now());
+        }
+        catch (...) {
+            return std::nullopt;
+        }
+    }
+
+    template <typename Fn>
+    void measure(BenchReport& report, const std::string& variant, const char* dataset,
+                 size_t samples, Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        size_t produced = fn();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        report.add({"formatter", variant, std::string("data=") + dataset + ";accepted=" + std::to_string(produced),
+                    "cost", elapsed.count() / static_cast<double>(samples), "ns/op"});
+    }
+
+    template <typename Policy>
+    void run(BenchReport& report, const char* policyName, const char* dataset,
+             const std::vector<std::string>& readings, const std::string& joined) {
+        LogFormatter<Policy> formatter("Bench", policyName);
+        const std::string prefix = policyName;
+
+        measure(report, prefix + "/formatDataToLogMsg", dataset, readings.size(), [&] {
+            size_t produced = 0;
+            for (const auto& reading : readings) {
+                if (formatter.formatDataToLogMsg(reading)) {
+                    ++produced;
+                }
+            }
+            return produced;
+        });
+
+        ReadingBatch batch;
+        measure(report, prefix + "/parseBatch", dataset, readings.size(), [&] {
+            formatter.parseBatch(joined, batch);
+            return batch.size() - batch.rejectedCount;
+        });
+    }
+
+    void runDataset(BenchReport& report, const char* dataset, size_t count, size_t badEvery) {
+        std::vector<std::string> readings;
+        std::string joined;
+        readings.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            if (badEvery != 0 && i % badEvery == 0) {
+                readings.push_back("garbage");
+            } else {
+                readings.push_back(std::to_string((i * 37) % 10000 / 100.0));
+            }
+            joined += readings.back();
+            joined += '\n';
+        }
+
+        const uint16_t app = StringRegistry::intern("Bench");
+        const uint16_t ctx = StringRegistry::intern("CpuPolicy");
+        const uint8_t policy = PolicyRegistry::idOf<CpuPolicy>();
+        measure(report, "CpuPolicy/legacy-stof", dataset, readings.size(), [&] {
+            size_t produced = 0;
+            for (const auto& reading : readings) {
+                if (legacyFormat<CpuPolicy>(app, ctx, policy, reading)) {
+                    ++produced;
+                }
+            }
+            return produced;
+        });
+
+        run<CpuPolicy>(report, "CpuPolicy", dataset, readings, joined);
+        run<RamPolicy>(report, "RamPolicy", dataset, readings, joined);
+        run<GpuPolicy>(report, "GpuPolicy", dataset, readings, joined);
+    }
+}
+
+void benchFormatter(BenchReport& report, const BenchOptions& options) {
+    const size_t count = SAMPLE_COUNT / options.scale;
+    runDataset(report, "clean", count, 0);
+    runDataset(report, "10pct-malformed", count, 10);
+}
@@ -0,0 +1,89 @@
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "BenchCases.hpp"
+#include "raii/SafeFile.hpp"
+
+// Reads the same generated telemetry file three ways: the old one-byte-per-
+// syscall loop, SafeFile::ReadLine and SafeFile::ReadLines.
+
+namespace {
+    constexpr size_t LINE_COUNT = 2'000'000;
+    const std::string BENCH_FILE = "/tmp/telelog_linereader_bench.txt";
+
+    void generateFile(size_t lineCount) {
+        std::ofstream out(BENCH_FILE, std::ios::trunc);
+        for (size_t i = 0; i < lineCount; ++i) {
+            out << (i % 10000) / 100.0 << '\n';
+        }
+    }
+
+    // The per-byte loop SafeFile::Read() used before the buffered reader
+    size_t legacyRead() {
+        int fd = open(BENCH_FILE.c_str(), O_RDONLY);
+        size_t lines = 0;
+        bool more = true;
+        while (more) {
+            std::string line;
+            char ch;
+            more = false;
+            while (read(fd, &ch, 1) == 1) {
+                more = true;
+                if (ch == '\n') {
+                    break;
+                }
+                line += ch;
+            }
+            if (more) {
+                ++lines;
+            }
+        }
+        close(fd);
+        return lines;
+    }
+
+    size_t bufferedReadLine() {
+        SafeFile file(BENCH_FILE);
+        size_t lines = 0;
+        std::string_view line;
+        while (file.ReadLine(line)) {
+            ++lines;
+        }
+        return lines;
+    }
+
+    size_t bufferedReadLines() {
+        SafeFile file(BENCH_FILE);
+        size_t lines = 0;
+        std::vector<std::string_view> batch;
+        while (file.ReadLines(batch)) {
+            lines += batch.size();
+        }
+        return lines;
+    }
+
+    template <typename Fn>
+    void measure(BenchReport& report, const char* variant, Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        size_t lines = fn();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        report.add({"line_reader", variant, "lines=" + std::to_string(lines),
+                    "throughput", lines / elapsed.count(), "lines/s"});
+    }
+}
+
+void benchLineReader(BenchReport& report, const BenchOptions& options) {
+    generateFile(LINE_COUNT / options.scale);
+
+    measure(report, "per-byte-read", legacyRead);
+    measure(report, "SafeFile::ReadLine", bufferedReadLine);
+    measure(report, "SafeFile::ReadLines", bufferedReadLines);
+
+    std::remove(BENCH_FILE.c_str());
+}
@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "BenchCases.hpp"
+#include "logger/LogManager.hpp"
+#include "formatter/LogFormatter.hpp"
+#include "formatter/policies/CpuPolicy.hpp"
+
+// Latency distribution of LogManager::addLog from one producer, with a sink
+// that discards everything so only the queueing path is measured. "shm-queue"
+// places the queue in a /dev/shm mapping (LogManagerConfig::sharedQueuePath).
+
+namespace {
+    constexpr size_t SAMPLE_COUNT = 1'000'000;
+
+    class NullSink : public ILogSink {
+    public:
+        void write(const LogMessage&) override {}
+        void writeBatch(const std::vector<LogMessage>&) override {}
+    };
+
+    void runOnce(BenchReport& report, const char* variant, const std::string& sharedQueuePath, size_t count) {
+        std::vector<double> latencies;
+        latencies.reserve(count);
+
+        LogFormatter<CpuPolicy> formatter("Bench", "CPU_LOAD");
+        LogMessage sample = *formatter.formatDataToLogMsg("42.0");
+        OverflowStats overflow;
+
+        {
+            LogManagerConfig config;
+            config.capacity = 65536;
+            config.sharedQueuePath = sharedQueuePath;
+            LogManager manager(config);
+            manager.addSink(std::make_unique<NullSink>());
+
+            for (size_t i = 0; i < count; ++i) {
+                LogMessage msg = sample;
+                auto start = std::chrono::steady_clock::now();
+                manager.addLog(std::move(msg));
+                auto end = std::chrono::steady_clock::now();
+                latencies.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+            }
+            overflow = manager.getOverflowStats();
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        const std::string param = "samples=" + std::to_string(count);
+        report.add({"addlog_latency", variant, param, "p50", percentile(latencies, 0.50), "ns"});
+        report.add({"addlog_latency", variant, param, "p99", percentile(latencies, 0.99), "ns"});
+        report.add({"addlog_latency", variant, param, "p99.9", percentile(latencies, 0.999), "ns"});
+        report.add({"addlog_latency", variant, param, "max", latencies.empty() ? 0.0 : latencies.back(), "ns"});
+        report.add({"addlog_latency", variant, param, "dropped",
+                    static_cast<double>(overflow.totalDropped()), "messages"});
+    }
+}
+
+void benchAddLogLatency(BenchReport& report, const BenchOptions& options) {
+    const size_t count = SAMPLE_COUNT / options.scale;
+    runOnce(report, "null-sink", "", count);
+    runOnce(report, "shm-queue", "/dev/shm/telelog_bench.queue", count);
+}
@@ -0,0 +1,110 @@
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ctime>
+
+#include "BenchCases.hpp"
+#include "logger/LogMessage.hpp"
+#include "logger/LogRenderer.hpp"
+#include "logger/StringRegistry.hpp"
+#include "logger/PolicyRegistry.hpp"
+
+// Lines per second for the former localtime/put_time/setw rendering versus
+// LogRenderer and the operator<< wrapper built on top of it.
+
+namespace {
+    constexpr size_t LINE_COUNT = 1'000'000;
+
+    // Six decimals like the std::to_string based legacy output
+    struct BenchPolicy {
+        static constexpr std::string_view unit = "%";
+        static constexpr std::string_view messageTemplate = "{context} usage: {value}{unit}";
+        static constexpr int precision = 6;
+    };
+
+    std::string legacyTypeToString(LogType type) {
+        switch (type) {
+            case LogType::INFO:    return "INFO";
+            case LogType::WARNING: return "WARNING";
+            case LogType::ERROR:   return "ERROR";
+            default:               return "UNKNOWN";
+        }
+    }
+
+    // Replica of operator<< before the renderer existed
+    void legacyRender(std::ostream& os, const LogMessage& msg) {
+        std::time_t t = std::chrono::system_clock::to_time_t(msg.getTimestamp());
+        std::tm tm = *std::localtime(&t);
+
+        os << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << " "
+           << "[" << std::left << std::setw(7) << legacyTypeToString(msg.getSeverity()) << "] "
+           << "[" << StringRegistry::lookup(msg.getAppId()) << "::"
+           << StringRegistry::lookup(msg.getContextId()) << "] "
+           << std::string(StringRegistry::lookup(msg.getContextId())) + " usage: "
+              + std::to_string(msg.getValue()) + std::string(PolicyRegistry::lookup(msg.getPolicyId()).unit);
+    }
+
+    template <typename Fn>
+    void measure(BenchReport& report, const char* variant, size_t lines, Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        size_t bytes = fn();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        report.add({"render", variant, "bytes=" + std::to_string(bytes),
+                    "throughput", lines / elapsed.count(), "lines/s"});
+    }
+}
+
+void benchRender(BenchReport& report, const BenchOptions& options) {
+    const size_t lineCount = LINE_COUNT / options.scale;
+    uint16_t app = StringRegistry::intern("Desktop-Linux");
+    uint16_t ctx = StringRegistry::intern("CPU_LOAD");
+    uint8_t policy = PolicyRegistry::idOf<BenchPolicy>();
+
+    // Messages spread over a few seconds so the prefix cache is exercised
+    std::vector<LogMessage> messages;
+    auto base = std::chrono::system_clock::now();
+    for (size_t i = 0; i < lineCount; ++i) {
+        messages.emplace_back(app, ctx, policy, static_cast<LogType>(i % 3),
+                              static_cast<float>(i % 10000) / 100.0f,
+                              base + std::chrono::microseconds(i * 5));
+    }
+
+    measure(report, "legacy-operator<<", lineCount, [&] {
+        std::ostringstream os;
+        for (const auto& msg : messages) {
+            legacyRender(os, msg);
+            os << '\n';
+        }
+        return os.str().size();
+    });
+
+    measure(report, "operator<<", lineCount, [&] {
+        std::ostringstream os;
+        for (const auto& msg : messages) {
+            os << msg << '\n';
+        }
+        return os.str().size();
+    });
+
+    measure(report, "LogRenderer::append", lineCount, [&] {
+        LogRenderer renderer;
+        std::string buffer;
+        buffer.reserve(lineCount * 80);
+        for (const auto& msg : messages) {
+            renderer.append(msg, buffer);
+        }
+        return buffer.size();
+    });
+
+    measure(report, "LogRenderer::render", lineCount, [&] {
+        LogRenderer renderer;
+        char line[LogRenderer::MAX_LINE];
+        size_t bytes = 0;
+        for (const auto& msg : messages) {
+            bytes += renderer.render(msg, line, sizeof(line)) + 1;
+        }
+        return bytes;
+    });
+}
@@ -0,0 +1,86 @@
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "BenchCases.hpp"
+#include "logger/RingBuffer.hpp"
+#include "logger/LockFreeRingBuffer.hpp"
+
+// Compares the mutex RingBuffer against LockFreeRingBuffer by pushing a fixed
+// number of items from N producer threads into one consumer thread.
+
+namespace {
+    constexpr size_t QUEUE_CAPACITY = 1024;
+    constexpr size_t TOTAL_ITEMS = 2'000'000;
+
+    template <typename Queue>
+    double runOnce(Queue& queue, size_t producers, size_t totalItems) {
+        const size_t perProducer = totalItems / producers;
+        const size_t expected = perProducer * producers;
+        std::atomic<bool> go{false};
+
+        std::thread consumer([&] {
+            size_t received = 0;
+            while (received < expected) {
+                if (queue.tryPop()) {
+                    ++received;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        std::vector<std::thread> workers;
+        for (size_t p = 0; p < producers; ++p) {
+            workers.emplace_back([&, p] {
+                while (!go.load(std::memory_order_acquire)) {
+                }
+                for (size_t i = 0; i < perProducer; ++i) {
+                    uint64_t item = (static_cast<uint64_t>(p) << 32) | i;
+                    while (!queue.tryPush(std::move(item))) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+
+        for (auto& t : workers) {
+            t.join();
+        }
+        consumer.join();
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(expected) / elapsed.count();
+    }
+
+    void addRow(BenchReport& report, const char* variant, size_t producers, double opsPerSec) {
+        report.add({"ring_buffer", variant, "producers=" + std::to_string(producers),
+                    "throughput", opsPerSec, "ops/s"});
+    }
+}
+
+void benchRingBuffer(BenchReport& report, const BenchOptions& options) {
+    const size_t total = TOTAL_ITEMS / options.scale;
+
+    {
+        LockFreeRingBuffer<uint64_t, QueueMode_enum::SPSC> queue(QUEUE_CAPACITY);
+        addRow(report, "lockfree-spsc", 1, runOnce(queue, 1, total));
+    }
+
+    for (size_t producers = 1; producers <= options.maxProducers; producers *= 2) {
+        RingBuffer<uint64_t> mutexQueue(QUEUE_CAPACITY);
+        addRow(report, "mutex", producers, runOnce(mutexQueue, producers, total));
+
+        LockFreeRingBuffer<uint64_t, QueueMode_enum::MPSC> mpscQueue(QUEUE_CAPACITY);
+        addRow(report, "lockfree-mpsc", producers, runOnce(mpscQueue, producers, total));
+
+        LockFreeRingBuffer<uint64_t, QueueMode_enum::MPMC> mpmcQueue(QUEUE_CAPACITY);
+        addRow(report, "lockfree-mpmc", producers, runOnce(mpmcQueue, producers, total));
+    }
+}
@@ -0,0 +1,121 @@
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "BenchCases.hpp"
+#include "logger/LogManager.hpp"
+#include "sources/SamplingScheduler.hpp"
+#include "sources/ProcStatCollectorImpl.hpp"
+#include "sources/MemInfoCollectorImpl.hpp"
+
+// Process CPU spent sampling /proc/stat (total + per core) and /proc/meminfo
+// every 10 ms from one SamplingScheduler thread. "noop" only pays for the
+// scheduler's wakeups, "proc-filtered" adds the reads and parsing (every
+// reading is below the severity floor, so nothing is queued), "proc-logged"
+// also delivers every reading through LogManager to a null sink.
+// "bare-sleep" and "bare-reads" are the floor without the library: a
+// clock_nanosleep loop on the same deadlines, the latter also doing the two
+// preads, so the difference to "noop" and "proc-filtered" is what the
+// scheduler and the collectors add.
+
+namespace {
+    constexpr auto INTERVAL = std::chrono::milliseconds(10);
+    constexpr int RUN_SECONDS = 4;
+
+    class NullSink : public ILogSink {
+    public:
+        void write(const LogMessage&) override {}
+        void writeBatch(const std::vector<LogMessage>&) override {}
+    };
+
+    class NoopCollector : public ITelemetryCollector {
+    public:
+        bool open() override { return true; }
+        bool collect(std::chrono::system_clock::time_point) override { return true; }
+    };
+
+    double cpuSeconds() {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+               (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    }
+
+    void runBare(BenchReport& report, const char* variant, bool reads, const BenchOptions& options) {
+        int stat = reads ? open("/proc/stat", O_RDONLY | O_CLOEXEC) : -1;
+        int meminfo = reads ? open("/proc/meminfo", O_RDONLY | O_CLOEXEC) : -1;
+        char buffer[16 * 1024];
+
+        auto duration = std::chrono::milliseconds(RUN_SECONDS * 1000 / options.scale);
+        const long steps = static_cast<long>(duration / INTERVAL);
+        double before = cpuSeconds();
+        timespec deadline{};
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        for (long i = 0; i < steps; ++i) {
+            deadline.tv_nsec += std::chrono::duration_cast<std::chrono::nanoseconds>(INTERVAL).count();
+            if (deadline.tv_nsec >= 1'000'000'000) {
+                deadline.tv_nsec -= 1'000'000'000;
+                ++deadline.tv_sec;
+            }
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr);
+            if (reads) {
+                (void)!pread(stat, buffer, sizeof(buffer), 0);
+                (void)!pread(meminfo, buffer, sizeof(buffer), 0);
+            }
+        }
+        double cpu = cpuSeconds() - before;
+        if (reads) {
+            close(stat);
+            close(meminfo);
+        }
+
+        double seconds = std::chrono::duration<double>(duration).count();
+        report.add({"sampling", variant, "interval=10ms", "cpu", 100.0 * cpu / seconds, "%"});
+    }
+
+    void runOnce(BenchReport& report, const char* variant, const BenchOptions& options) {
+        const std::string name = variant;
+        LogManager manager(4096);
+        manager.addSink(std::make_unique<NullSink>());
+        if (name == "proc-filtered") {
+            manager.setMinSeverity(LogType::ERROR);
+        }
+
+        SamplingScheduler scheduler;
+        if (name == "noop") {
+            scheduler.add(std::make_unique<NoopCollector>(), INTERVAL);
+        } else {
+            scheduler.add(std::make_unique<ProcStatCollectorImpl>(manager, "bench"), INTERVAL);
+            scheduler.add(std::make_unique<MemInfoCollectorImpl>(manager, "bench"), INTERVAL);
+        }
+
+        auto duration = std::chrono::milliseconds(RUN_SECONDS * 1000 / options.scale);
+        double before = cpuSeconds();
+        scheduler.start();
+        std::this_thread::sleep_for(duration);
+        scheduler.stop();
+        double cpu = cpuSeconds() - before;
+
+        SamplingStats stats = scheduler.getStats();
+        const std::string param = "interval=10ms,collectors=" + std::to_string(stats.collectors);
+        double seconds = std::chrono::duration<double>(duration).count();
+        report.add({"sampling", variant, param, "cpu", 100.0 * cpu / seconds, "%"});
+        report.add({"sampling", variant, param, "samples", static_cast<double>(stats.samples), "samples"});
+        report.add({"sampling", variant, param, "collect",
+                    stats.samples > 0 ? stats.collectNs / 1000.0 / stats.samples : 0.0, "us/sample"});
+        report.add({"sampling", variant, param, "overruns", static_cast<double>(stats.overruns), "ticks"});
+    }
+}
+
+void benchSampling(BenchReport& report, const BenchOptions& options) {
+    runBare(report, "bare-sleep", false, options);
+    runBare(report, "bare-reads", true, options);
+    runOnce(report, "noop", options);
+    runOnce(report, "proc-filtered", options);
+    runOnce(report, "proc-logged", options);
+}
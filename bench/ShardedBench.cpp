@@ -0,0 +1,137 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchCases.hpp"
+#include "logger/LogManager.hpp"
+#include "logger/ShardedLogManager.hpp"
+#include "formatter/LogFormatter.hpp"
+#include "formatter/policies/CpuPolicy.hpp"
+
+// Saturating producers, 1..N threads, into one LogManager versus a
+// ShardedLogManager with one shard per producer (sharded) or one per CPU
+// (sharded-cpu: shared shards, released by the reorder window). Throughput
+// is measured until the sink has seen every message; the sink also counts
+// timestamp inversions, i.e. how far from globally ordered its input was.
+
+namespace {
+    constexpr size_t TOTAL_MESSAGES = 2'000'000;
+    // Producers wait for space rather than drop, so every message is timed
+    constexpr std::chrono::milliseconds BLOCK_TIMEOUT{1000};
+
+    class OrderSink : public ILogSink {
+    public:
+        std::atomic<uint64_t> received{0};
+        uint64_t inversions = 0;
+        int64_t lastNs = INT64_MIN;
+
+        void write(const LogMessage& msg) override { take(msg); }
+
+        void writeBatch(const std::vector<LogMessage>& messages) override {
+            for (const auto& msg : messages) {
+                take(msg);
+            }
+        }
+
+    private:
+        void take(const LogMessage& msg) {
+            if (msg.getTimestampNs() < lastNs) {
+                ++inversions;
+            } else {
+                lastNs = msg.getTimestampNs();
+            }
+            received.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    uint64_t droppedBy(const LogManager& manager) {
+        return manager.getOverflowStats().totalDropped();
+    }
+
+    uint64_t droppedBy(const ShardedLogManager& manager) {
+        uint64_t dropped = manager.getMetrics().overflow.totalDropped();
+        for (const ShardStats& shard : manager.getStats().shards) {
+            dropped += shard.dropped;
+        }
+        return dropped;
+    }
+
+    template <typename Manager>
+    double pump(Manager& manager, const OrderSink& sink, size_t producers, size_t total) {
+        LogFormatter<CpuPolicy> formatter("Bench", "CPU_LOAD");
+        LogMessage sample = *formatter.formatDataToLogMsg("42.0");
+        const size_t perProducer = total / producers;
+        const size_t expected = perProducer * producers;
+        std::atomic<bool> go{false};
+
+        std::vector<std::thread> workers;
+        for (size_t p = 0; p < producers; ++p) {
+            workers.emplace_back([&] {
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (size_t i = 0; i < perProducer; ++i) {
+                    manager.addLog(LogMessage(sample.getAppId(), sample.getContextId(), sample.getPolicyId(),
+                                              sample.getSeverity(), sample.getValue()));
+                }
+            });
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        while (sink.received.load(std::memory_order_relaxed) + droppedBy(manager) < expected) {
+            std::this_thread::yield();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return expected / elapsed.count();
+    }
+
+    void addRows(BenchReport& report, const char* variant, size_t producers, double rate,
+                 const OrderSink& sink, uint64_t dropped) {
+        const std::string param = "producers=" + std::to_string(producers);
+        report.add({"sharded", variant, param, "throughput", rate, "msg/s"});
+        report.add({"sharded", variant, param, "inversions", static_cast<double>(sink.inversions), "messages"});
+        report.add({"sharded", variant, param, "dropped", static_cast<double>(dropped), "messages"});
+    }
+}
+
+void benchSharded(BenchReport& report, const BenchOptions& options) {
+    const size_t total = TOTAL_MESSAGES / options.scale;
+
+    for (size_t producers = 1; producers <= options.maxProducers; producers *= 2) {
+        {
+            LogManagerConfig config;
+            config.capacity = 8192;
+            config.overflow.policy = OverflowPolicy_enum::BLOCK_WITH_TIMEOUT;
+            config.overflow.blockTimeout = BLOCK_TIMEOUT;
+            LogManager manager(config);
+            auto sink = std::make_unique<OrderSink>();
+            OrderSink& observed = *sink;
+            manager.addSink(std::move(sink));
+            double rate = pump(manager, observed, producers, total);
+            addRows(report, "single-queue", producers, rate, observed, droppedBy(manager));
+        }
+        for (ShardAffinity_enum affinity : {ShardAffinity_enum::PER_THREAD, ShardAffinity_enum::PER_CPU}) {
+            ShardedLogManagerConfig config;
+            config.affinity = affinity;
+            if (affinity == ShardAffinity_enum::PER_THREAD) {
+                config.shards = producers;
+            }
+            config.overflow.policy = OverflowPolicy_enum::BLOCK_WITH_TIMEOUT;
+            config.overflow.blockTimeout = BLOCK_TIMEOUT;
+            ShardedLogManager manager(config);
+            auto sink = std::make_unique<OrderSink>();
+            OrderSink& observed = *sink;
+            manager.addSink(std::move(sink));
+            double rate = pump(manager, observed, producers, total);
+            addRows(report, affinity == ShardAffinity_enum::PER_CPU ? "sharded-cpu" : "sharded",
+                    producers, rate, observed, droppedBy(manager));
+        }
+    }
+}
@@ -0,0 +1,110 @@
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+
+#include "BenchCases.hpp"
+#include "logger/LogManager.hpp"
+#include "formatter/LogFormatter.hpp"
+#include "formatter/policies/CpuPolicy.hpp"
+
+// Consumer wakeup strategies under a saturating producer and a paced one
+// (bursts of 20 messages every millisecond). Per strategy: producer-side
+// notify calls, consumer parks, context switches and CPU time of the whole
+// process (getrusage), and the end-to-end p99 seen by a null sink.
+// "notify-every-push" reproduces the former cv.notify_one() per addLog.
+
+namespace {
+    constexpr size_t MAX_RATE_MESSAGES = 1'000'000;
+    constexpr size_t PACED_MESSAGES = 40'000;
+    constexpr size_t PACED_BURST = 20;
+
+    class NullSink : public ILogSink {
+    public:
+        void write(const LogMessage&) override {}
+        void writeBatch(const std::vector<LogMessage>&) override {}
+    };
+
+    struct Usage {
+        double cpuSeconds;
+        long contextSwitches;
+    };
+
+    Usage usageNow() {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        double cpu = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+                     (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+        return {cpu, usage.ru_nvcsw + usage.ru_nivcsw};
+    }
+
+    WakeupConfig legacyWakeup() {
+        WakeupConfig config;
+        config.spinFor = std::chrono::microseconds(0);
+        config.notifyEveryPush = true;
+        return config;
+    }
+
+    void runOnce(BenchReport& report, const char* variant, const WakeupConfig& wakeup,
+                 const char* load, size_t count, bool paced) {
+        LogFormatter<CpuPolicy> formatter("Bench", "CPU_LOAD");
+        LogMessage sample = *formatter.formatDataToLogMsg("42.0");
+
+        LogManagerConfig config;
+        config.capacity = 65536;
+        config.overflow.policy = OverflowPolicy_enum::BLOCK_WITH_TIMEOUT;
+        config.wakeup = wakeup;
+        LogManagerMetrics metrics;
+        Usage before = usageNow();
+        auto start = std::chrono::steady_clock::now();
+        {
+            LogManager manager(config);
+            manager.addSink(std::make_unique<NullSink>());
+
+            auto nextBurst = start;
+            for (size_t i = 0; i < count; ++i) {
+                if (paced && i % PACED_BURST == 0) {
+                    nextBurst += std::chrono::milliseconds(1);
+                    std::this_thread::sleep_until(nextBurst);
+                }
+                LogMessage msg(sample.getAppId(), sample.getContextId(), sample.getPolicyId(),
+                               sample.getSeverity(), sample.getValue());
+                manager.addLog(std::move(msg));
+            }
+            while (manager.getQueueDepth() > 0) {
+                std::this_thread::yield();
+            }
+            metrics = manager.getMetrics();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        Usage after = usageNow();
+
+        const std::string param = std::string(load) + ",messages=" + std::to_string(count);
+        double perThousand = 1000.0 / static_cast<double>(count);
+        report.add({"wakeup", variant, param, "throughput", count / elapsed.count(), "msg/s"});
+        report.add({"wakeup", variant, param, "notifies", metrics.notifies * perThousand, "per 1k msg"});
+        report.add({"wakeup", variant, param, "parks", metrics.parks * perThousand, "per 1k msg"});
+        report.add({"wakeup", variant, param, "context_switches",
+                    (after.contextSwitches - before.contextSwitches) * perThousand, "per 1k msg"});
+        report.add({"wakeup", variant, param, "cpu", (after.cpuSeconds - before.cpuSeconds) * 1e6 / count, "us/msg"});
+        if (!metrics.sinks.empty()) {
+            report.add({"wakeup", variant, param, "e2e_p99",
+                        static_cast<double>(metrics.sinks[0].endToEnd.p99Ns) / 1000.0, "us"});
+        }
+    }
+}
+
+void benchWakeup(BenchReport& report, const BenchOptions& options) {
+    const std::pair<const char*, WakeupConfig> strategies[] = {
+        {"notify-every-push", legacyWakeup()},
+        {"balanced", WakeupConfig{}},
+        {"low-latency", WakeupConfig::lowLatency()},
+        {"cpu-saving", WakeupConfig::cpuSaving()},
+    };
+
+    for (const auto& [name, wakeup] : strategies) {
+        runOnce(report, name, wakeup, "max-rate", MAX_RATE_MESSAGES / options.scale, false);
+        runOnce(report, name, wakeup, "paced-20k/s", PACED_MESSAGES / options.scale, true);
+    }
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+// Outcome of LogFormatter::tryFormat
+enum class FormatStatus_enum {
+    ACCEPTED,   // A LogMessage was produced
+    FILTERED,   // Valid reading below the compile-time or runtime threshold
+    REJECTED    // Malformed reading
+};
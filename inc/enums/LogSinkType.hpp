@@ -5,5 +5,8 @@
 enum class LogSinkType_enum {
     CONSOLE,    // Standard output
     FILE,       // File output
-    SOCKET      // Socket output
+    SOCKET,     // Socket output
+    MAPPED_FILE,// Preallocated, memory-mapped rotating segments
+    BINARY_FILE,// Compact binary records, decoded offline by TeleLogDecode
+    COMPRESSED_FILE // Compressed text blocks plus time index, read by TeleLogCat
 };
\ No newline at end of file
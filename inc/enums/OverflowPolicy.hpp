@@ -0,0 +1,10 @@
+#pragma once
+
+// What LogManager::addLog does when the queue is full
+enum class OverflowPolicy_enum {
+    BLOCK_WITH_TIMEOUT,     // Wait for space, drop once the timeout expires
+    SPIN_THEN_BLOCK,        // Retry briefly on-CPU, then behave like BLOCK_WITH_TIMEOUT
+    DROP_NEWEST,            // Reject the incoming message
+    DROP_OLDEST,            // Evict the oldest queued message to make room
+    DROP_BELOW_SEVERITY     // Shed messages below a severity, block for the rest
+};
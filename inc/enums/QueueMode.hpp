@@ -0,0 +1,8 @@
+#pragma once
+
+// Producer models supported by the lock-free ring buffer
+enum class QueueMode_enum {
+    SPSC,       // Single producer, single consumer
+    MPSC,       // Multiple producers, single consumer
+    MPMC        // Multiple producers, consumers may also race (e.g. overwrite-oldest)
+};
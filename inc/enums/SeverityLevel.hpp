@@ -1,8 +1,10 @@
 #pragma once 
 
+#include <cstdint>
+
 // Severity levels for log messages
-enum class SeverityLvl_enum {
+enum class SeverityLvl_enum : uint8_t {
     CRITICAL,   // Immediate action required
     WARNING,    // Warning condition
     INFO        // Informational
-};
\ No newline at end of file
+};
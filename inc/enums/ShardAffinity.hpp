@@ -0,0 +1,7 @@
+#pragma once
+
+// How ShardedLogManager picks the shard a producer pushes to
+enum class ShardAffinity_enum {
+    PER_THREAD,     // Least-used shard on a thread's first addLog, then fixed
+    PER_CPU         // The CPU the thread is running on (sched_getcpu)
+};
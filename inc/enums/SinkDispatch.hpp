@@ -0,0 +1,7 @@
+#pragma once
+
+// How LogManager hands drained batches to a sink
+enum class SinkDispatch_enum {
+    INLINE,     // Written on the LogManager worker thread
+    ASYNC       // Queued to a dedicated per-sink worker thread
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+// When a memory-mapped sink forces its pages to disk (msync)
+enum class SyncPolicy_enum {
+    NONE,           // Leave write-back to the kernel
+    INTERVAL,       // At most every syncInterval
+    BYTES,          // Whenever syncBytes were written since the last sync
+    ON_ERROR        // After any batch that contains an ERROR message
+};
@@ -1,10 +1,17 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <optional>
 #include <chrono>
+#include <vector>
 #include "logger/LogMessage.hpp"
+#include "logger/StringRegistry.hpp"
+#include "logger/PolicyRegistry.hpp"
+#include "logger/SeverityFilter.hpp"
 #include "enums/SeverityLevel.hpp"
+#include "enums/FormatStatus.hpp"
+#include "ReadingParser.hpp"
 
 // Bridge between Policy Severity and LogMessage Type
 inline LogType mapToLogType(SeverityLvl_enum level) {
@@ -15,20 +22,54 @@ inline LogType mapToLogType(SeverityLvl_enum level) {
     }
 }
 
-template <typename Policy>
+// MinLevel is fixed at compile time: readings classified below it are dropped
+// before a LogMessage is built and the comparison folds away when it is INFO.
+// A runtime SeverityFilter (usually LogManager::getSeverityFilter()) may be
+// bound on top of it.
+template <typename Policy, LogType MinLevel = COMPILED_MIN_SEVERITY>
 class LogFormatter {
 private:
-    std::string app_name;
-    std::string context;
+    // Interned once here; every message only carries the IDs
+    uint16_t appId;
+    uint16_t contextId;
+    uint8_t policyId;
+    const SeverityFilter* runtimeFilter = nullptr;
 
-    // Helper for message description
-    std::string msgDescription(float val) const;
+    bool passes(LogType level) const {
+        if (!isAtLeast(level, MinLevel)) {
+            return false;
+        }
+        return runtimeFilter == nullptr || runtimeFilter->allows(level);
+    }
 
 public:
-    LogFormatter(std::string app, std::string ctx);
+    LogFormatter(const std::string& app, const std::string& ctx);
+
+    // The filter must outlive the formatter
+    void bindFilter(const SeverityFilter& filter) { runtimeFilter = &filter; }
+
+    // Parse + classify + threshold check; out is only written when ACCEPTED
+    FormatStatus_enum tryFormat(std::string_view rawData, LogMessage& out) const;
+
+    // Same for readings that are already numbers (native collectors)
+    FormatStatus_enum tryFormatValue(float value, LogMessage& out,
+                                     std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now()) const;
+
+    //  Main formatting: parse + classify only, text is rendered by the sinks.
+    //  Filtered readings also yield nullopt, use tryFormat() to tell them apart
+    std::optional<LogMessage> formatDataToLogMsg(std::string_view rawData) const;
+
+    // Batch path: parses every newline-separated reading in buffer, then
+    // classifies the whole array against the policy thresholds
+    void parseBatch(std::string_view buffer, ReadingBatch& batch) const;
+
+    // Branch-free WARN/CRIT classification, written to auto-vectorize
+    static void classify(const float* values, SeverityLvl_enum* severities, size_t count);
 
-    //  Main formatting 
-    std::optional<LogMessage> formatDataToLogMsg(const std::string& rawData);
+    // Appends one LogMessage per accepted reading that passes the severity
+    // thresholds, returns how many
+    size_t appendLogMessages(const ReadingBatch& batch, std::vector<LogMessage>& out,
+                             std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now()) const;
 };
 
 // CRITICAL: Templates must have their implementation visible to the header
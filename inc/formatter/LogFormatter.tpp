@@ -1,30 +1,117 @@
 
 
 
-template <typename Policy>
-LogFormatter<Policy>::LogFormatter(std::string app, std::string ctx) 
-    : app_name(std::move(app)), context(std::move(ctx)) {}
+template <typename Policy, LogType MinLevel>
+LogFormatter<Policy, MinLevel>::LogFormatter(const std::string& app, const std::string& ctx) 
+    : appId(StringRegistry::intern(app)), 
+      contextId(StringRegistry::intern(ctx)),
+      policyId(PolicyRegistry::idOf<Policy>()) {}
 
-template <typename Policy>
-std::string LogFormatter<Policy>::msgDescription(float val) const {
-    return context + " usage: " + std::to_string(val) + std::string(Policy::unit);
+template <typename Policy, LogType MinLevel>
+FormatStatus_enum LogFormatter<Policy, MinLevel>::tryFormat(std::string_view rawData, LogMessage& out) const {
+    float value;
+    if (!parseReading(rawData, value)) {
+        return FormatStatus_enum::REJECTED;
+    }
+    LogType level = mapToLogType(Policy::inferSeverity(value));
+
+    // Before the clock read and the message construction
+    if (!passes(level)) {
+        return FormatStatus_enum::FILTERED;
+    }
+
+    out = LogMessage(appId, contextId, policyId, level, value, std::chrono::system_clock::now());
+    return FormatStatus_enum::ACCEPTED;
+}
+
+template <typename Policy, LogType MinLevel>
+FormatStatus_enum LogFormatter<Policy, MinLevel>::tryFormatValue(float value, LogMessage& out,
+                                                                 std::chrono::system_clock::time_point timestamp) const {
+    if (!std::isfinite(value)) {
+        return FormatStatus_enum::REJECTED;
+    }
+    LogType level = mapToLogType(Policy::inferSeverity(value));
+    if (!passes(level)) {
+        return FormatStatus_enum::FILTERED;
+    }
+
+    out = LogMessage(appId, contextId, policyId, level, value, timestamp);
+    return FormatStatus_enum::ACCEPTED;
 }
 
-template <typename Policy>
-std::optional<LogMessage> LogFormatter<Policy>::formatDataToLogMsg(const std::string& rawData) {
-    try {
-        float value = std::stof(rawData);
-        SeverityLvl_enum severity = Policy::inferSeverity(value);
-
-        return LogMessage(
-            app_name,
-            context,
-            mapToLogType(severity),
-            std::chrono::system_clock::now(),
-            msgDescription(value)
-        );
-    } 
-    catch (...) {
+template <typename Policy, LogType MinLevel>
+std::optional<LogMessage> LogFormatter<Policy, MinLevel>::formatDataToLogMsg(std::string_view rawData) const {
+    LogMessage message;
+    if (tryFormat(rawData, message) != FormatStatus_enum::ACCEPTED) {
         return std::nullopt;
     }
-}
\ No newline at end of file
+    return message;
+}
+
+template <typename Policy, LogType MinLevel>
+void LogFormatter<Policy, MinLevel>::classify(const float* values, SeverityLvl_enum* severities, size_t count) {
+    static_assert(Policy::CRIT_THRESHOLD >= Policy::WARN_THRESHOLD,
+                  "classify() assumes CRIT_THRESHOLD >= WARN_THRESHOLD");
+    static_assert(static_cast<int>(SeverityLvl_enum::CRITICAL) == 0 &&
+                  static_cast<int>(SeverityLvl_enum::WARNING) == 1 &&
+                  static_cast<int>(SeverityLvl_enum::INFO) == 2,
+                  "classify() derives the level arithmetically");
+
+    // INFO (2) minus one per crossed threshold, same result as Policy::inferSeverity
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t level = static_cast<uint8_t>(2 - (values[i] >= Policy::WARN_THRESHOLD)
+                                               - (values[i] >= Policy::CRIT_THRESHOLD));
+        severities[i] = static_cast<SeverityLvl_enum>(level);
+    }
+}
+
+template <typename Policy, LogType MinLevel>
+void LogFormatter<Policy, MinLevel>::parseBatch(std::string_view buffer, ReadingBatch& batch) const {
+    batch.clear();
+
+    size_t pos = 0;
+    while (pos < buffer.size()) {
+        size_t newline = buffer.find('\n', pos);
+        size_t end = newline == std::string_view::npos ? buffer.size() : newline;
+        std::string_view line = buffer.substr(pos, end - pos);
+        pos = end + 1;
+
+        if (line.empty() || (line.size() == 1 && line[0] == '\r')) {
+            continue; // Blank lines are not readings
+        }
+
+        size_t index = batch.values.size();
+        if (index % 64 == 0) {
+            batch.rejected.push_back(0);
+        }
+        float value;
+        if (parseReading(line, value)) {
+            batch.values.push_back(value);
+        } else {
+            batch.values.push_back(0.0f);
+            batch.rejected[index / 64] |= uint64_t{1} << (index % 64);
+            ++batch.rejectedCount;
+        }
+    }
+
+    batch.severities.resize(batch.values.size());
+    classify(batch.values.data(), batch.severities.data(), batch.values.size());
+}
+
+template <typename Policy, LogType MinLevel>
+size_t LogFormatter<Policy, MinLevel>::appendLogMessages(const ReadingBatch& batch, std::vector<LogMessage>& out,
+                                               std::chrono::system_clock::time_point timestamp) const {
+    size_t appended = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (batch.isRejected(i)) {
+            continue;
+        }
+        LogType level = mapToLogType(batch.severities[i]);
+        if (!passes(level)) {
+            continue;
+        }
+        out.emplace_back(appId, contextId, policyId, level, batch.values[i], timestamp);
+        ++appended;
+    }
+    return appended;
+}
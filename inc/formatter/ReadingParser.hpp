@@ -0,0 +1,56 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include "enums/SeverityLevel.hpp"
+
+// Locale-independent, exception-free parsing of one telemetry reading.
+// Surrounding blanks/'\r' and a leading '+' are accepted, anything else
+// after the number, NaN and infinities are rejected.
+inline bool parseReading(std::string_view text, float& value) {
+    size_t begin = 0;
+    size_t end = text.size();
+    while (begin < end && (text[begin] == ' ' || text[begin] == '\t')) {
+        ++begin;
+    }
+    while (end > begin && (text[end - 1] == ' ' || text[end - 1] == '\t' || text[end - 1] == '\r')) {
+        --end;
+    }
+    if (begin < end && text[begin] == '+') {
+        ++begin;
+    }
+    if (begin == end) {
+        return false;
+    }
+
+    const char* first = text.data() + begin;
+    const char* last = text.data() + end;
+    auto result = std::from_chars(first, last, value);
+    return result.ec == std::errc() && result.ptr == last && std::isfinite(value);
+}
+
+// Output of LogFormatter::parseBatch. Keep one instance around: clear()
+// keeps the capacity, so steady-state batches do not allocate.
+struct ReadingBatch {
+    std::vector<float> values;                  // 0 for rejected lines
+    std::vector<SeverityLvl_enum> severities;   // Meaningless for rejected lines
+    std::vector<uint64_t> rejected;             // Bit i set: line i did not parse
+    size_t rejectedCount = 0;
+
+    size_t size() const { return values.size(); }
+
+    bool isRejected(size_t index) const {
+        return (rejected[index / 64] >> (index % 64)) & 1u;
+    }
+
+    void clear() {
+        values.clear();
+        severities.clear();
+        rejected.clear();
+        rejectedCount = 0;
+    }
+};
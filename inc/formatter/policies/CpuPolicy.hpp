@@ -10,6 +10,9 @@ struct CpuPolicy {
     public:
     // Threshold values
     static constexpr std::string_view unit = "%";
+    // Description layout, see MessageTemplate
+    static constexpr std::string_view messageTemplate = "{context} usage: {value}{unit}";
+    static constexpr int precision = 2;
     static constexpr float WARN_THRESHOLD = 80.0f;
     static constexpr float CRIT_THRESHOLD = 95.0f;
 
@@ -9,6 +9,9 @@ struct RamPolicy {
     public:
     // Threshold values
     static constexpr std::string_view unit = "%";
+    // Description layout, see MessageTemplate
+    static constexpr std::string_view messageTemplate = "{context} usage: {value}{unit}";
+    static constexpr int precision = 2;
     static constexpr float WARN_THRESHOLD = 75.0f;
     static constexpr float CRIT_THRESHOLD = 95.0f;
 
@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "BatchPool.hpp"
+#include "LockFreeRingBuffer.hpp"
+#include "LogManagerConfig.hpp"
+#include "LogMetrics.hpp"
+#include "LogMessage.hpp"
+#include "sink/ILogSink.hpp"
+
+// Owns one sink plus a bounded queue and thread in front of it, so a slow
+// sink only delays itself. Fed by the LogManager worker.
+class AsyncSinkWorker {
+private:
+    struct Entry {
+        SharedBatch batch;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    std::unique_ptr<ILogSink> sink;
+    OverflowConfig overflow;
+    LockFreeRingBuffer<Entry, QueueMode_enum::MPMC> queue;
+
+    std::thread workerThread;
+    std::mutex mtx;
+    std::condition_variable dataCv;     // Worker waits for batches
+    std::condition_variable spaceCv;    // Blocking enqueue waits for room
+    std::atomic<bool> stopFlag{false};
+
+    std::atomic<int64_t> queuedBatches{0};
+    std::atomic<uint64_t> batchesWritten{0};
+    std::atomic<uint64_t> messagesWritten{0};
+    std::atomic<uint64_t> droppedBatches{0};
+    std::atomic<uint64_t> droppedMessages{0};
+    std::atomic<uint64_t> lastLagUs{0};
+    std::atomic<uint64_t> maxLagUs{0};
+
+    bool timed;
+    SinkTimings timings;
+
+    void processLoop();
+    void countDrop(const SharedBatch& batch);
+    bool tryPushCounted(Entry& entry);
+    bool push(Entry& entry);
+
+public:
+    AsyncSinkWorker(std::unique_ptr<ILogSink> sink, const SinkQueueConfig& config, bool timed = true);
+    ~AsyncSinkWorker();
+
+    AsyncSinkWorker(const AsyncSinkWorker&) = delete;
+    AsyncSinkWorker& operator=(const AsyncSinkWorker&) = delete;
+
+    // Applies the queue's overflow policy when full
+    void enqueue(const SharedBatch& batch);
+
+    SinkLagStats getStats() const;
+    const SinkTimings& getTimings() const { return timings; }
+    const ILogSink& getSink() const { return *sink; }
+};
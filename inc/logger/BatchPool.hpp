@@ -0,0 +1,46 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "LogMessage.hpp"
+
+// Batches are shared read-only between every ASYNC sink
+using SharedBatch = std::shared_ptr<const std::vector<LogMessage>>;
+
+// Recycles the batches LogManager shares with ASYNC sinks. Each slot is a
+// shared_ptr with reserved capacity that the pool keeps a reference to; once
+// every sink worker has dropped its copy the pool's reference is the only one
+// left and the slot is refilled in place. In steady state handing a batch to
+// the workers therefore costs neither a control block nor a vector
+// allocation, and no memory is freed on a worker thread.
+// acquire() must only be called from one thread (the LogManager consumer);
+// the counters and growLimit() are safe from any thread.
+class BatchPool {
+private:
+    std::vector<std::shared_ptr<std::vector<LogMessage>>> slots;
+    size_t nextSlot = 0;
+    size_t batchCapacity;
+    std::atomic<size_t> maxSlots;
+
+    std::atomic<size_t> slotsUsed{0};       // slots.size(), published for metrics
+    std::atomic<uint64_t> reused{0};
+    std::atomic<uint64_t> allocated{0};     // New slots plus unpooled overflow batches
+
+public:
+    explicit BatchPool(size_t batchCapacity, size_t maxSlots = 0);
+
+    BatchPool(const BatchPool&) = delete;
+    BatchPool& operator=(const BatchPool&) = delete;
+
+    // Raises the slot limit, e.g. by the depth of a newly added sink queue
+    void growLimit(size_t additionalSlots) { maxSlots.fetch_add(additionalSlots, std::memory_order_relaxed); }
+
+    // Copy of messages in a recycled slot when one is free
+    SharedBatch acquire(const std::vector<LogMessage>& messages);
+
+    size_t slotCount() const { return slotsUsed.load(std::memory_order_relaxed); }
+    uint64_t reusedCount() const { return reused.load(std::memory_order_relaxed); }
+    uint64_t allocationCount() const { return allocated.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// On-disk layout shared by BinarySink and BinaryLogReader.
+//
+//   file    := header record*
+//   header  := "TLOGBIN1" u16 version u16 reserved
+//   record  := varint payloadLength payload
+//   payload := u8 type body
+//
+// Record bodies (integers are LEB128 varints unless noted):
+//   TIME_BASE  i64 absolute timestamp (ns, little endian)
+//   STRING     id, length, bytes            dictionary entry for app/context IDs
+//   POLICY     u8 id, length, unit bytes    dictionary entry for policy IDs,
+//              then u8 precision, length, message template bytes (absent in
+//              older files: default template, six decimals)
+//   LOG        zigzag timestamp delta (ns), u8 severity, appId, contextId,
+//              u8 policyId, f32 value (little endian)
+//   AGGREGATE  LOG body followed by u8 kind, count, f32 min, f32 max, f32 mean
+//              (SUMMARY/REPEAT records from LogAggregator)
+//
+// Dictionary entries are emitted the first time an ID is written, so every
+// string is stored once per writer session while IDs stay runtime-interned.
+namespace BinaryLogFormat {
+    constexpr char MAGIC[8] = {'T', 'L', 'O', 'G', 'B', 'I', 'N', '1'};
+    constexpr uint16_t VERSION = 1;
+    constexpr size_t HEADER_SIZE = sizeof(MAGIC) + 2 * sizeof(uint16_t);
+    // Longer payloads are corruption; writers clip dictionary text to fit
+    constexpr size_t MAX_RECORD_BYTES = 64 * 1024;
+    constexpr size_t MAX_TEXT_BYTES = MAX_RECORD_BYTES / 2;
+    constexpr size_t MAX_VARINT_BYTES = 10;
+
+    enum class RecordType : uint8_t {
+        TIME_BASE = 0,
+        STRING = 1,
+        POLICY = 2,
+        LOG = 3,
+        AGGREGATE = 4
+    };
+
+    inline void putVarint(std::string& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    inline uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    inline int64_t unzigzag(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    // Fixed-width little-endian copy; the supported targets are little endian
+    template <typename T>
+    inline void putFixed(std::string& out, T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    // Bounds-checked cursor over a record payload
+    struct Reader {
+        const unsigned char* pos;
+        const unsigned char* end;
+
+        bool varint(uint64_t& value) {
+            value = 0;
+            for (int shift = 0; shift < 64 && pos < end; shift += 7) {
+                uint8_t byte = *pos++;
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template <typename T>
+        bool fixed(T& value) {
+            if (static_cast<size_t>(end - pos) < sizeof(T)) {
+                return false;
+            }
+            std::memcpy(&value, pos, sizeof(T));
+            pos += sizeof(T);
+            return true;
+        }
+
+        bool atEnd() const {
+            return pos == end;
+        }
+
+        bool bytes(std::string& out, size_t length) {
+            if (static_cast<size_t>(end - pos) < length) {
+                return false;
+            }
+            out.assign(reinterpret_cast<const char*>(pos), length);
+            pos += length;
+            return true;
+        }
+    };
+}
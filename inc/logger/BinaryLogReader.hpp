@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "LogMessage.hpp"
+
+// Sequential reader for files written by BinarySink. Dictionary records are
+// applied as they appear and their strings interned into this process's
+// registries, so the returned LogMessages render like live ones.
+class BinaryLogReader {
+private:
+    std::ifstream file;
+    bool valid = false;
+    std::vector<uint16_t> stringIds;    // File ID -> local StringRegistry ID
+    std::vector<uint8_t> policyIds;     // File ID -> local PolicyRegistry ID
+    int64_t lastTimestampNs = 0;
+    std::vector<unsigned char> payload;
+    uint64_t corruptRecords = 0;
+
+    bool readVarint(uint64_t& value);
+    bool applyRecord(LogMessage& out, bool& isLog);
+
+public:
+    explicit BinaryLogReader(const std::string& filePath);
+
+    bool isValid() const;
+
+    // Next LOG record; false at end of file or on a truncated record
+    bool next(LogMessage& out);
+
+    uint64_t skippedRecords() const;
+};
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Layout shared by CompressedFileSink and BlockLogReader.
+//
+//   data file  := "TLOGBLK1" block*
+//   block      := BlockHeader payload[storedBytes]
+//   index file := "TLOGIDX1" IndexEntry*          (written to "<data>.idx")
+//
+// A block holds rendered text lines, exactly what FileSink would have
+// written, compressed as one unit. The index lets readers seek straight to
+// the blocks whose time span overlaps a query; it can be rebuilt by walking
+// the block headers if it is lost. All integers are little endian.
+namespace BlockLogFormat {
+    constexpr char DATA_MAGIC[8] = {'T', 'L', 'O', 'G', 'B', 'L', 'K', '1'};
+    constexpr char INDEX_MAGIC[8] = {'T', 'L', 'O', 'G', 'I', 'D', 'X', '1'};
+    constexpr size_t MAGIC_SIZE = sizeof(DATA_MAGIC);
+    constexpr const char* INDEX_SUFFIX = ".idx";
+
+    enum class BlockCodec : uint8_t {
+        STORED = 0,     // Raw text, used when compression does not pay off
+        DEFLATE = 1     // zlib stream
+    };
+
+    struct BlockHeader {
+        uint32_t storedBytes;
+        uint32_t rawBytes;
+        uint32_t records;
+        uint8_t codec;
+        uint8_t reserved[3];
+        int64_t firstTimestampNs;   // Earliest record in the block
+        int64_t lastTimestampNs;    // Latest record in the block
+    };
+
+    struct IndexEntry {
+        uint64_t offset;            // Of the BlockHeader in the data file
+        BlockHeader header;
+    };
+
+    // Larger blocks are treated as corruption, so a torn header cannot make
+    // a reader allocate gigabytes
+    constexpr uint32_t MAX_RAW_BYTES = 64u * 1024 * 1024;
+
+    // Header fields a writer could have produced
+    inline bool plausible(const BlockHeader& header) {
+        if (header.rawBytes > MAX_RAW_BYTES) {
+            return false;
+        }
+        switch (static_cast<BlockCodec>(header.codec)) {
+            case BlockCodec::STORED:
+                return header.storedBytes == header.rawBytes;
+            case BlockCodec::DEFLATE:
+                return header.storedBytes < header.rawBytes;
+        }
+        return false;
+    }
+
+    static_assert(sizeof(BlockHeader) == 32, "BlockHeader is written as-is");
+    static_assert(sizeof(IndexEntry) == 40, "IndexEntry is written as-is");
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "BlockLogFormat.hpp"
+#include "raii/SafeFd.hpp"
+
+// Random access to files written by CompressedFileSink. The block list comes
+// from the "<path>.idx" index; blocks appended after the last index entry
+// (e.g. the index write was lost in a crash) are recovered by walking the
+// block headers, so the index is an accelerator, never a requirement.
+class BlockLogReader {
+private:
+    SafeFd file;
+    bool valid = false;
+    uint64_t fileSize = 0;
+    std::vector<BlockLogFormat::IndexEntry> entries;
+    size_t recovered = 0;
+    std::string compressed;         // Scratch for readBlock
+
+    void loadIndex(const std::string& indexPath);
+    void scanFrom(uint64_t offset);
+
+public:
+    explicit BlockLogReader(const std::string& filePath);
+
+    BlockLogReader(const BlockLogReader&) = delete;
+    BlockLogReader& operator=(const BlockLogReader&) = delete;
+
+    bool isValid() const;
+
+    // Every block in file order
+    const std::vector<BlockLogFormat::IndexEntry>& blocks() const;
+
+    // Positions in blocks() whose time span overlaps [fromNs, toNs]
+    std::vector<size_t> overlapping(int64_t fromNs, int64_t toNs) const;
+
+    // Decompressed text of one block; false if it is corrupt or the codec is unavailable
+    bool readBlock(const BlockLogFormat::IndexEntry& entry, std::string& text);
+
+    // Blocks found by scanning rather than through the index
+    size_t recoveredBlocks() const;
+};
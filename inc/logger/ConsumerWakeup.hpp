@@ -0,0 +1,115 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include "LogManagerConfig.hpp"
+
+// Spin-then-park handshake between producers and the one thread draining
+// their queues (the LogManager consumer, the ShardedLogManager merger). The
+// consumer polls for WakeupConfig::spinFor, then parks on a condition
+// variable; producers signal only while it is parked, so at steady high
+// rates pushes cost no syscalls.
+class ConsumerWakeup {
+private:
+    static constexpr uint32_t SPIN_CHECK_INTERVAL = 64;    // Polls between clock reads while spinning
+
+    WakeupConfig config;
+    alignas(64) std::atomic<bool> parked{false};    // Consumer is (about to be) blocked on cv
+    std::mutex mtx;
+    std::condition_variable cv;
+
+    std::atomic<uint64_t> parks{0};
+    std::atomic<uint64_t> spinWakeups{0};
+    std::atomic<uint64_t> notifies{0};
+
+public:
+    explicit ConsumerWakeup(const WakeupConfig& config) : config(config) {}
+
+    ConsumerWakeup(const ConsumerWakeup&) = delete;
+    ConsumerWakeup& operator=(const ConsumerWakeup&) = delete;
+
+    static void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    // Clock of LogMessage timestamps, in nanoseconds since the epoch
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // Consumer side: returns once ready() holds, a producer signalled, or
+    // maxPark passed. ready() must cover everything notify() reports
+    template <typename Ready>
+    void wait(Ready ready, std::chrono::steady_clock::duration maxPark = std::chrono::steady_clock::duration::max()) {
+        if (config.spinFor.count() > 0) {
+            auto deadline = std::chrono::steady_clock::now() + config.spinFor;
+            for (uint32_t i = 1;; ++i) {
+                if (ready()) {
+                    spinWakeups.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                if (i % SPIN_CHECK_INTERVAL == 0 && std::chrono::steady_clock::now() >= deadline) {
+                    break;
+                }
+                if (config.yieldWhileSpinning) {
+                    std::this_thread::yield();
+                } else {
+                    cpuRelax();
+                }
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mtx);
+        parked.store(true, std::memory_order_relaxed);
+        // Pairs with the fence in notify(): either this thread sees the
+        // producer's push or the producer sees parked == true
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto woken = [this, &ready] { return ready() || !parked.load(std::memory_order_relaxed); };
+        if (!woken()) {
+            parks.fetch_add(1, std::memory_order_relaxed);
+            if (maxPark == std::chrono::steady_clock::duration::max()) {
+                cv.wait(lock, woken);
+            } else {
+                cv.wait_for(lock, maxPark, woken);
+            }
+        }
+        parked.store(false, std::memory_order_relaxed);
+    }
+
+    // Producer side, after a push: signals only when the consumer is parked
+    void notify() {
+        if (config.notifyEveryPush) {
+            notifies.fetch_add(1, std::memory_order_relaxed);
+            cv.notify_one();
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parked.load(std::memory_order_relaxed) && parked.exchange(false)) {
+            notifies.fetch_add(1, std::memory_order_relaxed);
+            // Under the lock so the signal cannot fall between check and wait
+            std::lock_guard<std::mutex> lock(mtx);
+            cv.notify_one();
+        }
+    }
+
+    // Unconditional, for state changes the consumer must notice
+    void wakeAlways() {
+        parked.store(false);
+        std::lock_guard<std::mutex> lock(mtx);
+        cv.notify_all();
+    }
+
+    const WakeupConfig& getConfig() const { return config; }
+    uint64_t parkCount() const { return parks.load(std::memory_order_relaxed); }
+    uint64_t spinWakeupCount() const { return spinWakeups.load(std::memory_order_relaxed); }
+    uint64_t notifyCount() const { return notifies.load(std::memory_order_relaxed); }
+};
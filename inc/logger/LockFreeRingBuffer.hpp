@@ -0,0 +1,205 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "enums/QueueMode.hpp"
+
+// Bounded lock-free queue.
+// Every slot carries a sequence number (Vyukov style): a producer may only
+// construct into a slot whose sequence equals its ticket, and a consumer may
+// only read a slot whose sequence equals ticket + 1. In SPSC mode the single
+// producer just bumps its ticket, in MPSC/MPMC mode producers claim tickets
+// with a CAS. Only MPMC lets more than one thread pop concurrently.
+//
+// The slots may also live in caller-provided memory, e.g. a shared mapping
+// that outlives a crash (see SharedQueueFile). A slot whose sequence is
+// ticket + 1 holds a committed item, so the sequence numbers double as
+// per-slot commit markers for post-mortem readers.
+template <typename T, QueueMode_enum Mode = QueueMode_enum::MPSC>
+class LockFreeRingBuffer {
+public:
+    // Public for post-mortem readers of external storage
+    struct Slot {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static size_t roundUpPow2(size_t value) {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    // Bytes of external storage needed for a capacity
+    static size_t storageBytes(size_t capacity) {
+        return roundUpPow2(capacity) * sizeof(Slot);
+    }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    T* itemAt(Slot& slot) {
+        return std::launder(reinterpret_cast<T*>(slot.storage));
+    }
+
+    // Producer and consumer cursors live on their own cache lines
+    alignas(CACHE_LINE) std::atomic<size_t> enqueuePos{0};
+    alignas(CACHE_LINE) std::atomic<size_t> dequeuePos{0};
+    alignas(CACHE_LINE) size_t mask;
+    Slot* slots;
+    std::unique_ptr<Slot[]> owned;      // Null with external storage
+
+public:
+    // storage, if given, must hold storageBytes(capacity) suitably aligned
+    // bytes and outlive the queue; its previous content is discarded
+    explicit LockFreeRingBuffer(size_t capacity, void* storage = nullptr)
+        : mask(roundUpPow2(capacity) - 1) {
+        if (storage != nullptr) {
+            slots = static_cast<Slot*>(storage);
+            for (size_t i = 0; i <= mask; ++i) {
+                new (&slots[i]) Slot;
+            }
+        } else {
+            owned.reset(new Slot[mask + 1]);
+            slots = owned.get();
+        }
+        for (size_t i = 0; i <= mask; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~LockFreeRingBuffer() {
+        while (tryPop()) {
+        }
+    }
+
+    // Atomics are neither copyable nor movable
+    LockFreeRingBuffer(const LockFreeRingBuffer&) = delete;
+    LockFreeRingBuffer& operator=(const LockFreeRingBuffer&) = delete;
+
+    template <typename... Args>
+    bool tryEmplace(Args&&... args) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Slot* slot;
+
+        if constexpr (Mode == QueueMode_enum::SPSC) {
+            slot = &slots[pos & mask];
+            if (slot->sequence.load(std::memory_order_acquire) != pos) {
+                return false; // Buffer full
+            }
+            enqueuePos.store(pos + 1, std::memory_order_relaxed);
+        } else {
+            while (true) {
+                slot = &slots[pos & mask];
+                size_t seq = slot->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0) {
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false; // Buffer full
+                } else {
+                    pos = enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        new (slot->storage) T(std::forward<Args>(args)...);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(T&& item) {
+        return tryEmplace(std::move(item));
+    }
+
+    // Outside MPMC mode this must only be called from the consumer thread
+    std::optional<T> tryPop() {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Slot* slot;
+
+        if constexpr (Mode == QueueMode_enum::MPMC) {
+            while (true) {
+                slot = &slots[pos & mask];
+                size_t seq = slot->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0) {
+                    if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return std::nullopt; // Buffer empty
+                } else {
+                    pos = dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+        } else {
+            slot = &slots[pos & mask];
+            if (slot->sequence.load(std::memory_order_acquire) != pos + 1) {
+                return std::nullopt; // Buffer empty
+            }
+            dequeuePos.store(pos + 1, std::memory_order_relaxed);
+        }
+
+        T* item = itemAt(*slot);
+        std::optional<T> result(std::move(*item));
+        item->~T();
+        slot->sequence.store(pos + mask + 1, std::memory_order_release);
+        return result;
+    }
+
+    // Two-phase pop for the lone consumer: the item is copied out and the
+    // ticket claimed, but the slot stays committed, and unavailable to
+    // producers, until release(ticket). Items popped but not yet released
+    // thus remain readable by a post-mortem reader.
+    std::optional<T> tryPopHeld(size_t& ticket) {
+        static_assert(std::is_trivially_copyable_v<T>, "Held slots are read again after a crash");
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots[pos & mask];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return std::nullopt; // Buffer empty
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        ticket = pos;
+        return std::optional<T>(*itemAt(*slot));
+    }
+
+    void release(size_t ticket) {
+        slots[ticket & mask].sequence.store(ticket + mask + 1, std::memory_order_release);
+    }
+
+    // Exact for a lone consumer, a hint everywhere else
+    bool isEmpty() const {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        return slots[pos & mask].sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+    // Snapshot of the occupied slots, may be stale by the time it returns
+    size_t sizeApprox() const {
+        size_t head = dequeuePos.load(std::memory_order_relaxed);
+        size_t tail = enqueuePos.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    size_t capacity() const {
+        return mask + 1;
+    }
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "LogMessage.hpp"
+
+struct AggregationConfig {
+    std::chrono::milliseconds window{1000};    // One SUMMARY/REPEAT per stream and window
+    bool collapseRepeats = true;               // Identical readings become a REPEAT record
+};
+
+struct AggregationStats {
+    uint64_t messagesIn = 0;        // Messages of aggregated streams
+    uint64_t messagesOut = 0;       // Records emitted for them
+    uint64_t summaries = 0;
+    uint64_t repeats = 0;
+    uint64_t transitions = 0;       // Severity changes passed through immediately
+};
+
+// Per app/context windowed aggregation, run on the LogManager consumer thread.
+// Streams that are not enabled pass through untouched. For an enabled stream
+// the first reading and every severity change are forwarded at once (after
+// the pending window is closed), everything else is folded into the current
+// window, which is emitted as a single SUMMARY, REPEAT or, for one reading,
+// the reading itself once it is older than the configured window.
+class LogAggregator {
+private:
+    struct Window {
+        AggregationConfig config;
+        bool seen = false;              // First reading passes through
+        LogType severity = LogType::INFO;
+        int64_t startNs = 0;
+        uint32_t count = 0;
+        float minValue = 0.0f;
+        float maxValue = 0.0f;
+        double sum = 0.0;
+        LogMessage last;
+    };
+
+    static uint32_t keyOf(uint16_t appId, uint16_t contextId) {
+        return (static_cast<uint32_t>(appId) << 16) | contextId;
+    }
+
+    // Consumer-thread state
+    std::unordered_map<uint32_t, Window> streams;
+    AggregationStats local;
+
+    // Configuration handed over from other threads
+    std::mutex pendingMtx;
+    std::vector<std::pair<uint32_t, AggregationConfig>> pendingEnable;
+    std::vector<uint32_t> pendingDisable;
+    std::atomic<bool> hasPending{false};
+    std::atomic<bool> active{false};
+
+    // Published copy of local for getStats()
+    std::atomic<uint64_t> messagesIn{0};
+    std::atomic<uint64_t> messagesOut{0};
+    std::atomic<uint64_t> summaries{0};
+    std::atomic<uint64_t> repeats{0};
+    std::atomic<uint64_t> transitions{0};
+
+    void applyPending(std::vector<LogMessage>& out);
+    void closeWindow(Window& window, std::vector<LogMessage>& out);
+    void startWindow(Window& window, const LogMessage& msg);
+    void publishStats();
+
+public:
+    // May be called from any thread; applied before the next batch
+    void enable(uint16_t appId, uint16_t contextId, const AggregationConfig& config);
+    void disable(uint16_t appId, uint16_t contextId);
+
+    // Cheap check so the consumer can skip the stage entirely
+    bool isActive() const { return active.load(std::memory_order_relaxed) || hasPending.load(std::memory_order_relaxed); }
+
+    // Consumer thread only. Appends the records to forward for batch to out.
+    void process(const std::vector<LogMessage>& batch, std::vector<LogMessage>& out);
+
+    // Consumer thread only. Closes windows older than their interval at nowNs,
+    // or every window when nowNs is INT64_MAX (shutdown).
+    void flushExpired(int64_t nowNs, std::vector<LogMessage>& out);
+
+    AggregationStats getStats() const;
+};
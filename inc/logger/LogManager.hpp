@@ -5,35 +5,172 @@
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
-#include "RingBuffer.hpp"
+#include <string>
+#include "LockFreeRingBuffer.hpp"
+#include "SharedQueueFile.hpp"
+#include "AsyncSinkWorker.hpp"
+#include "ConsumerWakeup.hpp"
+#include "LogAggregator.hpp"
+#include "LogMetrics.hpp"
+#include "LogManagerConfig.hpp"
 #include "LogMessage.hpp"
+#include "SeverityFilter.hpp"
 #include "sink/ILogSink.hpp"
 
 class LogManager {
 private:
-    RingBuffer<LogMessage> queue;
+    // Backing file of queue when LogManagerConfig::sharedQueuePath is set;
+    // declared first so the mapping outlives the queue
+    std::unique_ptr<SharedQueueFile> sharedQueue;
+    std::vector<size_t> heldTickets;    // Popped, released once every sink has them
+
+    // A batch handed to the ASYNC sinks and the heldTickets it covers; the
+    // tickets are released once every worker has written or dropped it
+    struct HeldBatch {
+        SharedBatch batch;      // Null when no ASYNC sink got a copy
+        long idleRefs = 0;      // batch.use_count() with no worker holding it
+        size_t tickets = 0;     // Leading heldTickets entries after earlier batches
+    };
+    std::vector<HeldBatch> heldBatches;
+
+    // MPMC so DROP_OLDEST producers may evict from the head
+    LockFreeRingBuffer<QueuedMessage, QueueMode_enum::MPMC> queue;
     std::vector<std::unique_ptr<ILogSink>> sinks;
+    std::vector<std::unique_ptr<SinkTimings>> sinkTimings;     // Parallel to sinks
+
+    // ASYNC sinks: each drained batch is shared between their queues
+    std::vector<std::unique_ptr<AsyncSinkWorker>> asyncSinks;
+    BatchPool batchPool;                // Recycled batches handed to asyncSinks
+    SinkDispatch_enum defaultDispatch;
+    SinkQueueConfig defaultSinkQueue;
+
+    // Messages drained per wakeup are collected here and handed to the
+    // sinks as one batch; the vector is reused to avoid reallocating
+    size_t maxBatch;
+    std::vector<LogMessage> batch;
+    std::vector<LogMessage> sinkBatch;     // Per-sink subset when a sink filters by severity
+
+    // Optional per app/context windowing between the queue and the sinks
+    LogAggregator aggregator;
+    std::vector<LogMessage> aggregated;
+
+    // Runtime severity floor, shared with formatters through getSeverityFilter().
+    // Its floor tracks the lowest threshold of all sinks (see refreshSinkFloor)
+    SeverityFilter minSeverity;
+    std::mutex floorMtx;
+
+    // Overflow handling, only touched once the queue is full
+    OverflowConfig overflow;
+    struct alignas(64) OverflowCounters {
+        std::atomic<uint64_t> droppedNewest{0};
+        std::atomic<uint64_t> droppedOldest{0};
+        std::atomic<uint64_t> shedBySeverity{0};
+        std::atomic<uint64_t> blockTimeouts{0};
+        std::atomic<uint64_t> blockedPushes{0};
+        std::atomic<uint64_t> filtered{0};
+    } counters;
+    std::mutex spaceMtx;                    // Producers waiting for free slots
+    std::condition_variable spaceCv;
+    std::atomic<int> blockedProducers{0};
     
+    // Self-instrumentation; the consumer-side counters have a single writer
+    MetricsConfig metricsConfig;
+    std::chrono::steady_clock::time_point startedAt;
+    LatencyHistogram enqueueLatency;
+    std::atomic<uint64_t> wakeups{0};
+    std::atomic<uint64_t> batchesDrained{0};
+    std::atomic<uint64_t> messagesDrained{0};
+    std::atomic<size_t> queueHighWater{0};
+    std::thread reportThread;           // Only with MetricsConfig::reportInterval
+    std::mutex reportMtx;
+    std::condition_variable reportCv;
+
+    // Consumer wakeup, see WakeupConfig
+    ConsumerWakeup wakeup;
+
     // Threading components
     std::thread workerThread;
-    std::mutex cvMtx;              // Mutex specifically for the condition variable
-    std::condition_variable cv;    // For notifying the worker thread
     std::atomic<bool> stopFlag;    // Thread-safe shutdown signal
 
+    // ShardedLogManager runs its own merger thread and hands it the merged
+    // batches (deliverDrained), so its LogManager has no queue or worker
+    friend class ShardedLogManager;
+    LogManager(const LogManagerConfig& config, bool ownConsumer);
+
     // The function executed by the background thread
     void processLoop();
+    // Counts a drained batch and passes it through aggregation to the sinks
+    void deliverDrained(const std::vector<LogMessage>& messages, HeldBatch* held = nullptr);
+    // Closes aggregation windows expired at nowNs (INT64_MAX: all of them)
+    void flushAggregation(int64_t nowNs);
+    // Longest the consumer may park: open aggregation windows and batches
+    // still held by ASYNC sinks need a periodic wakeup
+    std::chrono::steady_clock::duration parkLimit() const;
+    // Fills held with the copy shared with ASYNC sinks, if any
+    void deliver(const std::vector<LogMessage>& messages, HeldBatch* held = nullptr);
+    // Releases the tickets of the leading heldBatches no worker still holds
+    void releaseDelivered();
+    void waitForMessages();
+    // Producer side: signals only when the consumer is parked
+    void wakeConsumer();
+    // Unconditional, for state changes the consumer must notice
+    void forceWake();
+    void reportLoop();
+    void wakeBlockedProducers();
+    // Raises minSeverity's floor to the lowest level any sink accepts, so
+    // messages every sink would discard are not queued; off while
+    // aggregation is enabled, which folds every reading into its windows
+    void refreshSinkFloor();
+
+    // addLog minus the timing
+    void enqueue(LogMessage&& msg);
+
+    // Slow path of addLog, applies the configured OverflowPolicy_enum
+    void handleOverflow(QueuedMessage&& msg);
+    bool blockForSpace(QueuedMessage& msg, bool spinFirst);
 
 public:
-    explicit LogManager(size_t capacity = 100);
+    explicit LogManager(size_t capacity = 100, size_t maxBatch = 256);
+    explicit LogManager(const LogManagerConfig& config);
     ~LogManager();
 
     // Prevent copies to avoid thread ownership issues
     LogManager(const LogManager&) = delete;
     LogManager& operator=(const LogManager&) = delete;
 
-    // Interface for the Producer (Telemetry Source)
+    // Interface for the Producer (Telemetry Source); the queue holds a
+    // QueuedMessage, so a SUMMARY record arrives as a SAMPLE of its last value
     void addLog(LogMessage&& msg);
     
     // Interface for Configuration
     void addSink(std::unique_ptr<ILogSink> sink);
-};
\ No newline at end of file
+    void addSink(std::unique_ptr<ILogSink> sink, SinkDispatch_enum dispatch);
+    void addSink(std::unique_ptr<ILogSink> sink, SinkDispatch_enum dispatch,
+                 const SinkQueueConfig& queueConfig);
+
+    // Messages below the level are discarded by addLog and by every
+    // formatter bound to getSeverityFilter(); may change at any time.
+    // Levels that no sink accepts are discarded the same way
+    void setMinSeverity(LogType level);
+    LogType getMinSeverity() const;
+    const SeverityFilter& getSeverityFilter() const;
+
+    // Folds the app/context stream into windowed SUMMARY/REPEAT records,
+    // severity changes still reach the sinks immediately
+    void enableAggregation(const std::string& app, const std::string& context,
+                           const AggregationConfig& config = {});
+    void disableAggregation(const std::string& app, const std::string& context);
+    AggregationStats getAggregationStats() const;
+
+    // One entry per ASYNC sink, in registration order
+    std::vector<SinkLagStats> getSinkLagStats() const;
+
+    // Messages lost or delayed because the queue was full
+    OverflowStats getOverflowStats() const;
+
+    // Approximate number of queued messages, allocation-free
+    size_t getQueueDepth() const;
+
+    // Queue occupancy, wakeups, latency histograms and per-sink timings
+    LogManagerMetrics getMetrics() const;
+};
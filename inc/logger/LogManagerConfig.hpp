@@ -0,0 +1,107 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "LogMessage.hpp"
+#include "enums/OverflowPolicy.hpp"
+#include "enums/SinkDispatch.hpp"
+
+// Behaviour of LogManager::addLog once the queue is full
+struct OverflowConfig {
+    OverflowPolicy_enum policy = OverflowPolicy_enum::DROP_NEWEST;
+    std::chrono::milliseconds blockTimeout{10};   // BLOCK_WITH_TIMEOUT / SPIN_THEN_BLOCK
+    size_t spinIterations = 2000;                   // SPIN_THEN_BLOCK
+    LogType keepAtOrAbove = LogType::WARNING;       // DROP_BELOW_SEVERITY
+};
+
+// Snapshot of the overflow counters kept by LogManager
+struct OverflowStats {
+    uint64_t droppedNewest = 0;     // Rejected by DROP_NEWEST
+    uint64_t droppedOldest = 0;     // Evicted from the queue by DROP_OLDEST
+    uint64_t shedBySeverity = 0;    // Rejected by DROP_BELOW_SEVERITY
+    uint64_t blockTimeouts = 0;     // Gave up waiting for space
+    uint64_t blockedPushes = 0;     // Had to wait for space but were queued
+    uint64_t filtered = 0;          // Rejected by addLog: below the manager's or every sink's
+                                    // threshold. Intentional, so not part of totalDropped()
+
+    uint64_t totalDropped() const {
+        return droppedNewest + droppedOldest + shedBySeverity + blockTimeouts;
+    }
+};
+
+// Queue in front of an ASYNC sink; it holds shared batches, not messages.
+// DROP_BELOW_SEVERITY has no meaning for whole batches and acts as DROP_NEWEST.
+struct SinkQueueConfig {
+    size_t depth = 64;          // Batches
+    OverflowConfig overflow;
+};
+
+// Snapshot of one ASYNC sink's queue
+struct SinkLagStats {
+    uint64_t batchesWritten = 0;
+    uint64_t messagesWritten = 0;
+    uint64_t droppedBatches = 0;
+    uint64_t droppedMessages = 0;
+    size_t queuedBatches = 0;
+    uint64_t lastLagUs = 0;     // Enqueue to writeBatch completion, last batch
+    uint64_t maxLagUs = 0;
+};
+
+// How the LogManager consumer waits for messages. It polls for spinFor after
+// running dry, then parks on a condition variable; producers only signal
+// (mutex + futex) when they see the parked flag, so at steady high rates
+// pushes cost no syscalls at all.
+struct WakeupConfig {
+    std::chrono::microseconds spinFor{20};          // Poll the queue this long before parking
+    bool yieldWhileSpinning = true;                 // sched_yield between polls instead of a pause loop
+    std::chrono::microseconds batchLinger{0};       // After a wakeup, let a small batch grow this long
+    bool notifyEveryPush = false;                   // Former behaviour, kept for comparison
+
+    // Hot consumer core, lowest end-to-end latency
+    static WakeupConfig lowLatency() {
+        WakeupConfig config;
+        config.spinFor = std::chrono::microseconds(200);
+        config.yieldWhileSpinning = false;
+        return config;
+    }
+
+    // Parks right away and drains in larger, less frequent batches
+    static WakeupConfig cpuSaving() {
+        WakeupConfig config;
+        config.spinFor = std::chrono::microseconds(0);
+        config.batchLinger = std::chrono::microseconds(1000);
+        return config;
+    }
+};
+
+// Self-instrumentation, see LogManager::getMetrics()
+struct MetricsConfig {
+    bool enabled = true;
+    uint32_t enqueueSampleEvery = 64;               // Time one addLog in N per thread
+    std::chrono::milliseconds reportInterval{0};    // Periodic self-report line, 0 = off
+    std::ostream* reportStream = nullptr;           // nullptr = std::clog
+};
+
+struct LogManagerConfig {
+    size_t capacity = 100;
+    size_t maxBatch = 256;      // Messages handed to the sinks per writeBatch
+    OverflowConfig overflow;
+
+    // Initial runtime threshold, see LogManager::setMinSeverity()
+    LogType minSeverity = LogType::INFO;
+
+    // Default dispatch for addSink(); ASYNC gives each sink its own worker
+    SinkDispatch_enum sinkDispatch = SinkDispatch_enum::INLINE;
+    SinkQueueConfig sinkQueue;
+
+    MetricsConfig metrics;
+    WakeupConfig wakeup;
+
+    // Keeps the queue in a file mapping (e.g. "/dev/shm/telelog.queue") so
+    // records not yet delivered survive a crash, see SharedQueueFile.
+    // A slot is reused only once every sink, ASYNC ones included, has it.
+    // Empty keeps it on the heap
+    std::string sharedQueuePath;
+};
@@ -2,30 +2,122 @@
 
 #include <string>
 #include <chrono>
+#include <cstdint>
 #include <ostream>
+#include <type_traits>
 
-enum class LogType {
+enum class LogType : uint8_t {
     INFO,
     WARNING,
     ERROR
 };
 
+// What a record stands for; SUMMARY and REPEAT come from LogAggregator
+enum class LogKind : uint8_t {
+    SAMPLE,     // One reading
+    SUMMARY,    // A window of readings: value is the last one, see min/max/mean/count
+    REPEAT      // count identical readings collapsed into one record
+};
+
+// Compact, trivially copyable log record. Strings are referenced through
+// StringRegistry IDs and the description is rendered from the raw value by
+// the policy registered under policyId, so producers never allocate.
+// Queues carry the smaller QueuedMessage below.
 class LogMessage {
 private:
-    std::string app_name;
-    std::string context;
-    std::chrono::time_point<std::chrono::system_clock> timestamp;
-    LogType severity;
-    std::string message;
+    friend class QueuedMessage;
+
+    int64_t timestampNs = 0;        // system_clock time since epoch
+    float value = 0.0f;             // Raw telemetry reading
+    float minValue = 0.0f;          // Aggregate fields, only meaningful for SUMMARY
+    float maxValue = 0.0f;
+    float meanValue = 0.0f;
+    uint32_t count = 1;             // Readings represented by this record
+    uint16_t appId = 0;             // StringRegistry ID
+    uint16_t contextId = 0;         // StringRegistry ID
+    uint8_t policyId = 0;           // PolicyRegistry ID
+    LogType severity = LogType::INFO;
+    LogKind kind = LogKind::SAMPLE;
 
 public:
-    LogMessage(const std::string& app_name,
-               const std::string& context,
+    LogMessage() = default;
+    LogMessage(uint16_t appId,
+               uint16_t contextId,
+               uint8_t policyId,
                LogType severity,
-               std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now(),
-               const std::string& message = "");
+               float value,
+               std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now());
+
+    // Window of readings ending with last, which provides value, IDs and timestamp
+    static LogMessage summary(const LogMessage& last, uint32_t count, float minValue, float maxValue, float meanValue);
+    // count copies of sample
+    static LogMessage repeat(const LogMessage& sample, uint32_t count);
+
+    LogType getSeverity() const { return severity; }
+    LogKind getKind() const { return kind; }
+    uint32_t getCount() const { return count; }
+    float getMinValue() const { return minValue; }
+    float getMaxValue() const { return maxValue; }
+    float getMeanValue() const { return meanValue; }
+    float getValue() const { return value; }
+    uint16_t getAppId() const { return appId; }
+    uint16_t getContextId() const { return contextId; }
+    uint8_t getPolicyId() const { return policyId; }
+    int64_t getTimestampNs() const { return timestampNs; }
+    std::chrono::system_clock::time_point getTimestamp() const;
+
+    // Policy message template, e.g. "<context> usage: <value><unit>", built on demand on the consumer side
+    std::string describe() const;
 
     friend std::ostream& operator<<(std::ostream& os, const LogMessage& msg);
+};
 
-    ~LogMessage() = default;
+static_assert(std::is_trivially_copyable_v<LogMessage>, "LogMessage must stay a POD record");
+
+// What the ring buffers hold: a LogMessage minus the SUMMARY aggregates,
+// which LogAggregator only builds after the queue. 24 bytes instead of 40.
+// A SUMMARY handed to a queue travels as a SAMPLE of its last value.
+class QueuedMessage {
+private:
+    int64_t timestampNs = 0;
+    float value = 0.0f;
+    uint32_t count = 1;
+    uint16_t appId = 0;
+    uint16_t contextId = 0;
+    uint8_t policyId = 0;
+    LogType severity = LogType::INFO;
+    LogKind kind = LogKind::SAMPLE;
+
+public:
+    QueuedMessage() = default;
+    explicit QueuedMessage(const LogMessage& msg)
+        : timestampNs{msg.timestampNs}, value{msg.value}, appId{msg.appId}, contextId{msg.contextId},
+          policyId{msg.policyId}, severity{msg.severity} {
+        if (msg.kind == LogKind::REPEAT) {
+            kind = LogKind::REPEAT;
+            count = msg.count;
+        }
+    }
+
+    LogType getSeverity() const { return severity; }
+    int64_t getTimestampNs() const { return timestampNs; }
+
+    LogMessage toMessage() const {
+        LogMessage msg;
+        msg.timestampNs = timestampNs;
+        msg.value = value;
+        msg.count = count;
+        msg.appId = appId;
+        msg.contextId = contextId;
+        msg.policyId = policyId;
+        msg.severity = severity;
+        msg.kind = kind;
+        if (kind == LogKind::REPEAT) {
+            msg.minValue = msg.maxValue = msg.meanValue = value;
+        }
+        return msg;
+    }
 };
+
+static_assert(std::is_trivially_copyable_v<QueuedMessage>, "QueuedMessage must stay a POD record");
+static_assert(sizeof(QueuedMessage) == 24, "QueuedMessage is sized for two slots per cache line");
@@ -0,0 +1,145 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "LogManagerConfig.hpp"
+#include "enums/SinkDispatch.hpp"
+
+// Percentiles are the upper bound of the bucket holding them (<= 12.5% high)
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    uint64_t sumNs = 0;
+    uint64_t maxNs = 0;
+    uint64_t p50Ns = 0;
+    uint64_t p90Ns = 0;
+    uint64_t p99Ns = 0;
+    uint64_t p999Ns = 0;
+
+    uint64_t meanNs() const { return count ? sumNs / count : 0; }
+};
+
+// Log-linear (HDR style) latency histogram: 8 linear sub-buckets per power
+// of two, so any value up to 2^63 ns lands in one of 496 buckets with at
+// most 12.5% relative error. record() is a handful of relaxed atomics and
+// is safe from any thread.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 3;
+    static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BITS;
+    static constexpr size_t BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+private:
+    std::atomic<uint64_t> buckets[BUCKETS];
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> max{0};
+
+    static size_t indexOf(uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return static_cast<size_t>(value);
+        }
+        int msb = 63 - __builtin_clzll(value);
+        int shift = msb - SUB_BITS;
+        return static_cast<size_t>(msb - SUB_BITS + 1) * SUB_BUCKETS + ((value >> shift) & (SUB_BUCKETS - 1));
+    }
+
+    static uint64_t upperBoundOf(size_t index);
+
+public:
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(uint64_t valueNs) {
+        buckets[indexOf(valueNs)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(valueNs, std::memory_order_relaxed);
+        uint64_t seen = max.load(std::memory_order_relaxed);
+        while (valueNs > seen && !max.compare_exchange_weak(seen, valueNs, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Same result as record() for every valueAt(i), i < n, but consecutive
+    // values in one bucket (typical for the ages of one batch) share a
+    // single atomic add, and count, sum and max are published once
+    template <typename ValueAt>
+    void recordMany(size_t n, ValueAt valueAt) {
+        if (n == 0) {
+            return;
+        }
+        uint64_t total = 0;
+        uint64_t largest = 0;
+        size_t runIndex = BUCKETS;
+        uint64_t runLength = 0;
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t value = valueAt(i);
+            total += value;
+            largest = value > largest ? value : largest;
+            size_t index = indexOf(value);
+            if (index != runIndex) {
+                if (runLength > 0) {
+                    buckets[runIndex].fetch_add(runLength, std::memory_order_relaxed);
+                }
+                runIndex = index;
+                runLength = 0;
+            }
+            ++runLength;
+        }
+        buckets[runIndex].fetch_add(runLength, std::memory_order_relaxed);
+        count.fetch_add(n, std::memory_order_relaxed);
+        sum.fetch_add(total, std::memory_order_relaxed);
+        uint64_t seen = max.load(std::memory_order_relaxed);
+        while (largest > seen && !max.compare_exchange_weak(seen, largest, std::memory_order_relaxed)) {
+        }
+    }
+
+    HistogramSnapshot snapshot() const;
+};
+
+// Timings of one sink, written by whichever thread calls it
+struct SinkTimings {
+    LatencyHistogram writeTime;     // One writeBatch call
+    LatencyHistogram endToEnd;      // LogMessage timestamp to writeBatch completion
+    std::atomic<uint64_t> batches{0};
+
+    // Records a finished writeBatch that started at start; messages is what
+    // the sink actually wrote, nothing is recorded if it is empty
+    void recordBatch(const std::vector<LogMessage>& messages, std::chrono::steady_clock::time_point start);
+};
+
+struct SinkMetrics {
+    SinkDispatch_enum dispatch = SinkDispatch_enum::INLINE;
+    uint64_t batches = 0;
+    HistogramSnapshot writeTime;
+    HistogramSnapshot endToEnd;
+};
+
+// Point-in-time view returned by LogManager::getMetrics()
+struct LogManagerMetrics {
+    double uptimeSeconds = 0.0;
+    size_t queueCapacity = 0;
+    size_t queueDepth = 0;          // Approximate, producers keep running
+    size_t queueHighWater = 0;      // Deepest queue seen by the consumer
+    uint64_t wakeups = 0;           // Consumer wakeups since construction
+    uint64_t parks = 0;             // Times the consumer blocked on the condition variable
+    uint64_t spinWakeups = 0;       // Times new messages arrived while it was still polling
+    uint64_t notifies = 0;          // Producer-side notify calls (potential futex syscalls)
+    uint64_t batches = 0;           // Batches drained from the queue
+    uint64_t messages = 0;          // Messages drained from the queue
+    HistogramSnapshot enqueueLatency;   // addLog, sampled (MetricsConfig::enqueueSampleEvery)
+    OverflowStats overflow;
+    size_t batchPoolSlots = 0;          // Batches recycled for ASYNC sinks
+    uint64_t batchPoolReused = 0;
+    uint64_t batchPoolAllocations = 0;  // Should stop growing once warmed up
+    std::vector<SinkMetrics> sinks;     // Inline sinks first, then ASYNC ones, each in registration order
+
+    double wakeupsPerSecond() const { return uptimeSeconds > 0 ? wakeups / uptimeSeconds : 0.0; }
+};
+
+// One-line summary used by the periodic self-report. previous (may be null)
+// turns the counters into rates over the interval between the two snapshots.
+std::string describeMetrics(const LogManagerMetrics& current, const LogManagerMetrics* previous);
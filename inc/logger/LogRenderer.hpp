@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "LogMessage.hpp"
+#include "MessageTemplate.hpp"
+
+struct RenderOptions {
+    bool utc = false;               // gmtime instead of local time, suffixed with 'Z'
+    int subSecondDigits = 0;        // 0, 3 (ms), 6 (us) or 9 (ns)
+};
+
+// Renders LogMessage lines straight into caller-provided memory:
+// "YYYY-MM-DD HH:MM:SS [LEVEL  ] [app::context] <description>"
+// The date/time prefix is cached per second, numbers go through to_chars and
+// the severity tags are precomputed. Not thread-safe: use one per thread/sink.
+class LogRenderer {
+private:
+    RenderOptions options;
+    int64_t cachedSecond;
+    char cachedPrefix[19];          // "YYYY-MM-DD HH:MM:SS", not terminated
+
+    void refreshPrefix(int64_t second);
+
+public:
+    // Stack buffer of append() and operator<<. Lines do not get cut: one
+    // whose maxLineLength() exceeds it (long app/context names) is rendered
+    // through the heap instead
+    static constexpr size_t MAX_LINE = 512;
+    static_assert(MessageTemplate::MAX_RENDERED < MAX_LINE, "A description alone must fit a line");
+
+    // Capacity that always holds msg's line, newline excluded
+    static size_t maxLineLength(const LogMessage& msg);
+
+    explicit LogRenderer(RenderOptions options = {});
+
+    // Writes one line without newline, returns the number of bytes written
+    size_t render(const LogMessage& msg, char* out, size_t capacity);
+
+    // Appends one line plus '\n' to a reusable text buffer
+    void append(const LogMessage& msg, std::string& buffer);
+
+    // The policy's message template only
+    static size_t renderDescription(const LogMessage& msg, char* out, size_t capacity);
+    static size_t maxDescriptionLength(const LogMessage& msg);
+};
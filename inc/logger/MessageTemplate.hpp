@@ -0,0 +1,117 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+// Description layout of a telemetry policy, e.g. "{context} usage: {value}{unit}".
+// Parsed once (at compile time for policy types) into literal and field
+// pieces, so rendering is a walk over the pieces with to_chars for the value.
+// Placeholders: {context}, {value} (fixed notation, `precision` decimals), {unit}.
+class MessageTemplate {
+public:
+    enum class Field : uint8_t { LITERAL, CONTEXT, VALUE, UNIT };
+
+    struct Piece {
+        Field field = Field::LITERAL;
+        std::string_view literal;
+    };
+
+    static constexpr std::string_view DEFAULT_TEXT = "{context} usage: {value}{unit}";
+    static constexpr int DEFAULT_PRECISION = 6;
+    static constexpr int MAX_PRECISION = 9;
+    static constexpr size_t MAX_PIECES = 8;
+    // Bound of a description apart from its {context} names, summary suffix included
+    static constexpr size_t MAX_RENDERED = 320;
+
+    std::string_view text;
+    Piece pieces[MAX_PIECES];
+    size_t count = 0;
+    int precision = DEFAULT_PRECISION;
+    bool valid = false;
+
+    // Unknown placeholders, unbalanced braces, too many pieces or a precision
+    // outside [0, MAX_PRECISION] leave valid == false
+    static constexpr MessageTemplate parse(std::string_view text, int precision) {
+        MessageTemplate result;
+        result.text = text;
+        result.precision = precision;
+        if (precision < 0 || precision > MAX_PRECISION) {
+            return result;
+        }
+
+        size_t pos = 0;
+        while (pos < text.size()) {
+            if (result.count == MAX_PIECES) {
+                return result;
+            }
+            Piece& piece = result.pieces[result.count++];
+            size_t open = text.find('{', pos);
+            if (open != pos) {
+                size_t end = open == std::string_view::npos ? text.size() : open;
+                if (text.substr(pos, end - pos).find('}') != std::string_view::npos) {
+                    return result;
+                }
+                piece.literal = text.substr(pos, end - pos);
+                pos = end;
+                continue;
+            }
+            size_t close = text.find('}', open);
+            if (close == std::string_view::npos) {
+                return result;
+            }
+            std::string_view name = text.substr(open + 1, close - open - 1);
+            if (name == "context") {
+                piece.field = Field::CONTEXT;
+            } else if (name == "value") {
+                piece.field = Field::VALUE;
+            } else if (name == "unit") {
+                piece.field = Field::UNIT;
+            } else {
+                return result;
+            }
+            pos = close + 1;
+        }
+        result.valid = true;
+        return result;
+    }
+
+    static constexpr MessageTemplate makeDefault() {
+        return parse(DEFAULT_TEXT, DEFAULT_PRECISION);
+    }
+
+    // Longest fixed-notation float: sign, every integer digit of FLT_MAX, '.', decimals
+    static constexpr size_t maxValueLength(int precision) {
+        return 1 + (std::numeric_limits<float>::max_exponent10 + 1) + (precision > 0 ? 1 + precision : 0);
+    }
+
+    constexpr size_t contextSlots() const {
+        size_t slots = 0;
+        for (size_t i = 0; i < count; ++i) {
+            slots += pieces[i].field == Field::CONTEXT ? 1 : 0;
+        }
+        return slots;
+    }
+
+    // Worst case of the template plus the longest kind suffix
+    // (" [n=<u32> min <v><u> max <v><u> mean <v><u>]"), not counting the
+    // context name, which is never cut: add contextSlots() times its length
+    constexpr size_t maxRenderedLength(size_t unitLength) const {
+        size_t length = 0;
+        for (size_t i = 0; i < count; ++i) {
+            switch (pieces[i].field) {
+                case Field::LITERAL: length += pieces[i].literal.size(); break;
+                case Field::CONTEXT: break;
+                case Field::VALUE:   length += maxValueLength(precision); break;
+                case Field::UNIT:    length += unitLength; break;
+            }
+        }
+        constexpr size_t U32_DIGITS = 10;
+        size_t summary = std::string_view(" [n=").size() + U32_DIGITS + std::string_view(" min ").size() +
+                         std::string_view(" max ").size() + std::string_view(" mean ").size() + 1 +
+                         3 * (maxValueLength(precision) + unitLength);
+        return length + summary;
+    }
+};
+
+static_assert(MessageTemplate::makeDefault().valid, "The default template must parse");
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include "MessageTemplate.hpp"
+
+// Runtime description of a telemetry policy, used when a LogMessage that
+// only carries a policy ID is rendered on the consumer side
+struct PolicyInfo {
+    std::string_view unit;
+    MessageTemplate message = MessageTemplate::makeDefault();
+};
+
+class PolicyRegistry {
+public:
+    static constexpr uint8_t GENERIC_ID = 0;   // Plain value, no unit
+    static constexpr size_t MAX_POLICIES = 256;
+
+    // Thread-safe; exhausting the table falls back to GENERIC_ID
+    static uint8_t add(const PolicyInfo& info);
+
+    // Lock-free; unknown IDs resolve to the generic entry
+    static const PolicyInfo& lookup(uint8_t id);
+
+    // Registered policies, including the generic one
+    static size_t size();
+
+    // Policy read back from a log or queue file: one ID per distinct
+    // unit/template/precision, texts are copied into the string registry.
+    // An invalid template falls back to the default one.
+    static uint8_t define(std::string_view unit, std::string_view messageTemplate, int precision);
+
+    // Compile-time parsed Policy::messageTemplate / Policy::precision
+    template <typename Policy>
+    static constexpr MessageTemplate messageOf() {
+        constexpr MessageTemplate message = MessageTemplate::parse(Policy::messageTemplate, Policy::precision);
+        static_assert(message.valid, "Policy::messageTemplate: unknown placeholder, stray brace, "
+                                     "too many pieces or precision out of range");
+        static_assert(message.maxRenderedLength(Policy::unit.size()) <= MessageTemplate::MAX_RENDERED,
+                      "Worst-case description of this policy does not fit MessageTemplate::MAX_RENDERED");
+        return message;
+    }
+
+    // One ID per policy type, assigned on first use
+    template <typename Policy>
+    static uint8_t idOf() {
+        static const uint8_t id = add(PolicyInfo{Policy::unit, messageOf<Policy>()});
+        return id;
+    }
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "LogMessage.hpp"
+
+// Build-time floor, set through the TELELOG_MIN_SEVERITY CMake cache entry
+// (0 = INFO, 1 = WARNING, 2 = ERROR). Levels below it are compiled out of
+// LogFormatter and never become LogMessages.
+#ifndef TELELOG_MIN_SEVERITY
+#define TELELOG_MIN_SEVERITY 0
+#endif
+
+constexpr LogType COMPILED_MIN_SEVERITY = static_cast<LogType>(TELELOG_MIN_SEVERITY);
+
+constexpr bool isAtLeast(LogType level, LogType minimum) {
+    return static_cast<uint8_t>(level) >= static_cast<uint8_t>(minimum);
+}
+
+// Runtime threshold that can be changed while producers are running.
+// A relaxed load and one compare per check. Besides the configured minimum
+// the owner may raise a floor (LogManager: the lowest level any of its sinks
+// still accepts); allows() applies whichever is higher.
+class SeverityFilter {
+private:
+    // Configured minimum in the low byte, floor in the high byte
+    std::atomic<uint16_t> levels;
+
+    static uint8_t effective(uint16_t packed) {
+        uint8_t configured = static_cast<uint8_t>(packed & 0xFF);
+        uint8_t floor = static_cast<uint8_t>(packed >> 8);
+        return configured > floor ? configured : floor;
+    }
+
+    void update(uint16_t keepMask, uint16_t bits) {
+        uint16_t current = levels.load(std::memory_order_relaxed);
+        while (!levels.compare_exchange_weak(current, static_cast<uint16_t>((current & keepMask) | bits),
+                                             std::memory_order_relaxed)) {
+        }
+    }
+
+public:
+    explicit SeverityFilter(LogType minimum = LogType::INFO)
+        : levels(static_cast<uint8_t>(minimum)) {}
+
+    SeverityFilter(const SeverityFilter&) = delete;
+    SeverityFilter& operator=(const SeverityFilter&) = delete;
+
+    void setMinSeverity(LogType minimum) {
+        update(0xFF00, static_cast<uint8_t>(minimum));
+    }
+
+    LogType getMinSeverity() const {
+        return static_cast<LogType>(levels.load(std::memory_order_relaxed) & 0xFF);
+    }
+
+    void setFloor(LogType floor) {
+        update(0x00FF, static_cast<uint16_t>(static_cast<uint8_t>(floor) << 8));
+    }
+
+    LogType getFloor() const {
+        return static_cast<LogType>(levels.load(std::memory_order_relaxed) >> 8);
+    }
+
+    bool allows(LogType level) const {
+        return static_cast<uint8_t>(level) >= effective(levels.load(std::memory_order_relaxed));
+    }
+};
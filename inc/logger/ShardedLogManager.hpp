@@ -0,0 +1,167 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "ConsumerWakeup.hpp"
+#include "LockFreeRingBuffer.hpp"
+#include "LogManager.hpp"
+#include "LogManagerConfig.hpp"
+#include "LogMessage.hpp"
+#include "enums/ShardAffinity.hpp"
+
+struct ShardedLogManagerConfig {
+    size_t shards = 0;                  // 0 = one per hardware thread
+    size_t shardCapacity = 4096;
+    ShardAffinity_enum affinity = ShardAffinity_enum::PER_THREAD;
+
+    // A shard head is held back until this much older than now, unless every
+    // shard has a message buffered and a single producer. Wider windows
+    // tolerate slower producers.
+    std::chrono::microseconds reorderWindow{2000};
+    size_t mergeBatch = 256;            // Messages pulled from a shard at a time
+
+    // Full shard: DROP_NEWEST drops, every other policy retries for
+    // blockTimeout (yielding) and then drops
+    OverflowConfig overflow;
+    WakeupConfig wakeup;                // Merger thread idling
+
+    // Delivery side: sinks, dispatch, maxBatch, metrics and severity. The
+    // shards take the place of its queue, so capacity, overflow, wakeup and
+    // sharedQueuePath are not used
+    LogManagerConfig output;
+};
+
+struct ShardStats {
+    uint64_t pushed = 0;
+    uint64_t dropped = 0;
+    size_t depth = 0;                   // Approximate
+    uint32_t producers = 0;             // Live threads assigned (PER_THREAD)
+};
+
+struct ShardedStats {
+    std::vector<ShardStats> shards;
+    uint64_t merged = 0;                // Handed to the sinks
+    uint64_t late = 0;                  // Older than a message already merged
+    uint64_t windowWaits = 0;           // Merger idled on the reorder window
+};
+
+// Front end that spreads producers over per-shard lock-free queues instead
+// of the single LogManager queue. One merger thread k-way merges the shard
+// heads by LogMessage timestamp into batches and hands them straight to the
+// sinks of a queue-less LogManager, so sinks still see one stream in
+// timestamp order. A shard with a single producer is FIFO in timestamp
+// order, so once every shard has a message buffered nothing older than the
+// oldest head can follow and it is released. Shards written by several
+// threads (PER_CPU, or more threads than shards) are sorted as they are
+// staged and, like every head while some shard is empty, released once
+// reorderWindow old. Messages that arrive later than that are still
+// delivered and counted as late.
+class ShardedLogManager {
+private:
+    using ShardQueue = LockFreeRingBuffer<QueuedMessage, QueueMode_enum::MPSC>;
+    using Head = std::pair<int64_t, uint32_t>;      // (timestamp, shard)
+
+    struct alignas(64) Shard {
+        ShardQueue queue;
+        std::atomic<uint64_t> pushed{0};
+        std::atomic<uint64_t> dropped{0};
+        // Shared with the leases, which may outlive the manager
+        std::shared_ptr<std::atomic<uint32_t>> producers = std::make_shared<std::atomic<uint32_t>>(0);
+
+        explicit Shard(size_t capacity) : queue(capacity) {}
+    };
+
+    // A thread's shard in the manager it last logged to. Released when the
+    // thread exits or moves to another manager, so producers counts only
+    // live threads
+    struct ProducerLease {
+        uint64_t owner = 0;
+        Shard* shard = nullptr;
+        std::shared_ptr<std::atomic<uint32_t>> producers;
+
+        ProducerLease() = default;
+        ProducerLease(const ProducerLease&) = delete;
+        ProducerLease& operator=(const ProducerLease&) = delete;
+        ~ProducerLease() { release(); }
+
+        void release() {
+            if (producers) {
+                producers->fetch_sub(1, std::memory_order_relaxed);
+                producers.reset();
+            }
+            owner = 0;
+            shard = nullptr;
+        }
+    };
+
+    // Merger-side buffer of messages pulled from one shard
+    struct Staging {
+        std::vector<QueuedMessage> messages;
+        size_t next = 0;
+
+        bool empty() const { return next == messages.size(); }
+    };
+
+    ShardedLogManagerConfig config;
+    const uint64_t instanceId;          // Tells thread-cached shard choices apart
+    std::atomic<size_t> nextShard{0};
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    // Sinks and delivery; has no queue or worker of its own
+    LogManager output;
+
+    // Merger state, only touched by mergerThread
+    std::vector<Staging> staging;
+    std::vector<Head> heads;            // Min-heap over the staged fronts
+    bool headsStale = false;            // A refill re-sorted a staged front
+    size_t idleShards = 0;              // Shards with nothing staged
+    int64_t lastMergedNs;
+    std::vector<LogMessage> mergedBatch;
+
+    std::atomic<uint64_t> merged{0};
+    std::atomic<uint64_t> late{0};
+    std::atomic<uint64_t> windowWaits{0};
+    std::atomic<uint64_t> wakeups{0};
+
+    ConsumerWakeup wakeup;
+    std::thread mergerThread;
+    std::atomic<bool> stopFlag{false};
+
+    Shard& shardForThisThread();
+    void pushFull(Shard& shard, QueuedMessage&& msg);
+    // Several producers push to it, so its order is not timestamp order
+    bool isShared(uint32_t index) const;
+
+    void mergeLoop();
+    bool refill(uint32_t index);
+    void rebuildHeads();
+    // Delivers every head that may go out now, returns how many
+    size_t mergeReady(bool draining);
+    void idle();
+    bool anyShardPending() const;
+
+public:
+    explicit ShardedLogManager(const ShardedLogManagerConfig& config = {});
+    ~ShardedLogManager();
+
+    ShardedLogManager(const ShardedLogManager&) = delete;
+    ShardedLogManager& operator=(const ShardedLogManager&) = delete;
+
+    void addLog(LogMessage&& msg);
+
+    // Forwarded to the delivery side
+    void addSink(std::unique_ptr<ILogSink> sink);
+    void addSink(std::unique_ptr<ILogSink> sink, SinkDispatch_enum dispatch);
+    void setMinSeverity(LogType level);
+    const SeverityFilter& getSeverityFilter() const;
+
+    size_t shardCount() const;
+    ShardedStats getStats() const;
+    // Sink metrics and batches of the delivery side; queue and wakeup
+    // figures describe the shards and the merger
+    LogManagerMetrics getMetrics() const;
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "LogMessage.hpp"
+#include "SharedQueueFormat.hpp"
+
+struct SharedQueueRecovery {
+    bool valid = false;             // File mapped and layout matches this build
+    bool cleanShutdown = false;
+    int32_t ownerPid = 0;
+    uint64_t capacity = 0;
+    uint64_t committed = 0;         // Records recovered
+};
+
+// Memory-mapped file that backs LogManager's queue when
+// LogManagerConfig::sharedQueuePath is set (see SharedQueueFormat.hpp).
+// Records sit in the mapping from addLog until the consumer has handed them
+// to the sinks, so after a crash they are still in the page cache (or
+// /dev/shm) for recover(). The owner holds an flock on the file, so a
+// second manager on the same path fails instead of truncating a live queue.
+// An existing file that was not closed cleanly is moved to "<path>.crash"
+// (".crash.1", ".crash.2"... if earlier copies are still there) instead of
+// being overwritten; a clean close removes the file.
+class SharedQueueFile {
+private:
+    std::string path;
+    int fd = -1;
+    void* base = nullptr;
+    size_t mappedBytes = 0;
+    SharedQueueFormat::Header* header = nullptr;
+    char* names = nullptr;
+
+    std::mutex namesMtx;
+    std::atomic<size_t> publishedStrings{0};
+    std::atomic<size_t> publishedPolicies{0};
+
+    void appendName(SharedQueueFormat::NameKind kind, size_t id, std::string_view text);
+
+public:
+    // Sized for LogManager's queue of capacity messages. Throws
+    // std::runtime_error if the file cannot be created and mapped, if a
+    // live process holds its lock, or if an unclean file cannot be preserved
+    SharedQueueFile(const std::string& path, size_t capacity);
+    ~SharedQueueFile();
+
+    SharedQueueFile(const SharedQueueFile&) = delete;
+    SharedQueueFile& operator=(const SharedQueueFile&) = delete;
+
+    void* slotStorage() const;
+
+    // Registry entries were added since the last syncNames(); two loads
+    bool namesStale() const;
+    // Mirrors them into the names area, before records can refer to them
+    void syncNames();
+
+    // Everything was delivered: the file is removed on destruction
+    void markClean();
+
+    // Committed records of a queue file, oldest first, with names interned
+    // into this process's registries
+    static SharedQueueRecovery recover(const std::string& path, std::vector<LogMessage>& out);
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Layout of the file behind a crash-surviving LogManager queue (see
+// SharedQueueFile), normally under /dev/shm:
+//
+//   Header | names area (namesBytes) | slots (capacity * slotBytes)
+//
+// The slots are a LockFreeRingBuffer<QueuedMessage, MPMC> placed in the
+// mapping; a slot whose sequence is ticket + 1 holds a committed record
+// that was not yet released by the consumer. The names area mirrors the
+// StringRegistry / PolicyRegistry entries the records refer to, so another
+// process can render them. Readers must check version, slotBytes and
+// recordBytes before touching the slots.
+namespace SharedQueueFormat {
+    constexpr char MAGIC[8] = {'T', 'L', 'O', 'G', 'S', 'H', 'Q', '1'};
+    constexpr uint32_t VERSION = 3;
+    constexpr size_t NAMES_BYTES = 64 * 1024;
+    constexpr const char* CRASH_SUFFIX = ".crash";
+
+    enum class State : uint32_t {
+        OPEN = 1,       // Owned by a live LogManager, or it died
+        CLEAN = 2       // Drained and closed normally
+    };
+
+    // names area entry := u8 kind, u16 id, u8 length, text[length]
+    // POLICY text       := u8 precision, u8 unitLength, unit, message template
+    enum class NameKind : uint8_t {
+        STRING = 1,     // StringRegistry ID -> text
+        POLICY = 2      // PolicyRegistry ID -> unit and message template
+    };
+    constexpr size_t NAME_ENTRY_HEADER = 4;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerBytes;
+        uint32_t slotBytes;
+        uint32_t recordBytes;
+        uint64_t capacity;
+        uint64_t namesOffset;
+        uint64_t namesBytes;
+        uint64_t slotsOffset;
+        int64_t createdNs;
+        int32_t ownerPid;
+        std::atomic<uint32_t> state;
+        std::atomic<uint32_t> namesUsed;    // Published bytes of the names area
+        uint8_t reserved[52];
+    };
+
+    static_assert(sizeof(Header) == 128, "Header is mapped as-is");
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "Header atomics are shared between processes");
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+// Process-wide interning of application and context names.
+// LogMessage stores the returned 16-bit IDs instead of owning strings;
+// the text is looked up again only when a message is rendered.
+class StringRegistry {
+public:
+    static constexpr uint16_t INVALID_ID = 0xFFFF;
+
+    // Thread-safe; returns the same ID for equal strings
+    static uint16_t intern(std::string_view text);
+
+    // Lock-free; unknown IDs yield "?"
+    static std::string_view lookup(uint16_t id);
+
+    static size_t size();
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Sidecar index FileSink writes next to a plain text log as "<log>.tix".
+//
+//   index file := "TLOGTIX1" record*
+//   record     := SESSION  Session
+//               | CONTEXT  u8 bit, u8 length, name[length]
+//               | CHECKPOINT Checkpoint
+//
+// Every record starts with its RecordType byte. A checkpoint covers a run of
+// whole lines [offset, offset + bytes) of the log and summarises it: time
+// span, severities present and which contexts appear, as a bitmap whose bits
+// are assigned by CONTEXT records. A SESSION record starts each sink
+// lifetime and resets those assignments, so a log reopened in append mode
+// keeps one index. A SESSION whose startOffset lies below the end of an
+// earlier checkpoint means the log was truncated in between; readers drop
+// the checkpoints before it. Text outside every checkpoint (written before the index
+// existed, or after the last checkpoint) must be scanned. Little endian.
+namespace TextIndexFormat {
+    constexpr char INDEX_MAGIC[8] = {'T', 'L', 'O', 'G', 'T', 'I', 'X', '1'};
+    constexpr size_t MAGIC_SIZE = sizeof(INDEX_MAGIC);
+    constexpr const char* INDEX_SUFFIX = ".tix";
+
+    // Contexts beyond the named bits share the last one
+    constexpr uint8_t CONTEXT_BITS = 64;
+    constexpr uint8_t OVERFLOW_BIT = CONTEXT_BITS - 1;
+
+    enum class RecordType : uint8_t {
+        SESSION = 1,
+        CONTEXT = 2,
+        CHECKPOINT = 3
+    };
+
+    struct Session {
+        uint64_t startOffset;       // Log size when the sink opened it
+        uint8_t utc;                // RenderOptions the lines were written with
+        uint8_t subSecondDigits;
+        uint8_t reserved[6];
+    };
+
+    struct Checkpoint {
+        uint64_t offset;
+        uint32_t bytes;
+        uint32_t records;
+        int64_t minTimestampNs;     // Lines are not strictly time ordered
+        int64_t maxTimestampNs;
+        uint64_t contextMask;
+        uint8_t severityMask;       // Bit per LogType
+        uint8_t reserved[7];
+    };
+
+    // Bytes of the record starting at data, 0 if it is unknown or torn
+    inline size_t recordSize(const char* data, size_t left) {
+        if (left == 0) {
+            return 0;
+        }
+        size_t size = 0;
+        switch (static_cast<RecordType>(data[0])) {
+            case RecordType::SESSION: size = 1 + sizeof(Session); break;
+            case RecordType::CHECKPOINT: size = 1 + sizeof(Checkpoint); break;
+            case RecordType::CONTEXT:
+                size = left >= 3 ? size_t{3} + static_cast<uint8_t>(data[2]) : left + 1;
+                break;
+            default: return 0;
+        }
+        return size <= left ? size : 0;
+    }
+
+    static_assert(sizeof(Session) == 16, "Session is written as-is");
+    static_assert(sizeof(Checkpoint) == 48, "Checkpoint is written as-is");
+}
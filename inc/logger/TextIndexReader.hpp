@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "LogRenderer.hpp"
+#include "TextIndexFormat.hpp"
+#include "raii/SafeFd.hpp"
+
+struct TextIndexQuery {
+    int64_t fromNs = INT64_MIN;
+    int64_t toNs = INT64_MAX;
+    uint8_t severityMask = 0xFF;    // Bit per LogType
+    std::string context;            // Empty matches every context
+};
+
+// Byte range of the log that may hold matching lines. Unindexed regions
+// carry no summary and always have to be scanned.
+struct TextRegion {
+    uint64_t offset;
+    uint64_t bytes;
+    bool indexed;
+};
+
+// Narrows a FileSink text log down to the regions a query has to read, using
+// the "<log>.tix" sidecar (see TextIndexFormat.hpp). Without an index, or
+// for text the index does not cover, it degrades to a sequential scan.
+class TextIndexReader {
+private:
+    struct SessionInfo {
+        RenderOptions renderOptions;
+        std::unordered_map<std::string, uint8_t> contextBits;
+    };
+
+    struct Entry {
+        TextIndexFormat::Checkpoint checkpoint;
+        size_t session;
+    };
+
+    SafeFd file;
+    uint64_t fileSize = 0;
+    bool indexLoaded = false;
+    std::vector<SessionInfo> sessions;
+    std::vector<Entry> entries;     // Ascending, non-overlapping
+    std::string chunk;              // Scratch for forEachLine
+
+    void loadIndex(const std::string& indexPath);
+    bool matches(const Entry& entry, const TextIndexQuery& query) const;
+
+public:
+    explicit TextIndexReader(const std::string& logPath);
+
+    TextIndexReader(const TextIndexReader&) = delete;
+    TextIndexReader& operator=(const TextIndexReader&) = delete;
+
+    bool isValid() const;           // The log itself could be opened
+    bool hasIndex() const;
+    size_t checkpoints() const;
+    uint64_t logBytes() const;
+    uint64_t indexedBytes() const;
+
+    // Of the most recent session, so the caller can parse line timestamps
+    RenderOptions renderOptions() const;
+
+    // Regions to read in file order; adjacent ones are merged
+    std::vector<TextRegion> select(const TextIndexQuery& query) const;
+
+    // Calls handler for every complete line of the region, newline excluded
+    bool forEachLine(const TextRegion& region, const std::function<void(std::string_view)>& handler);
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "LogMessage.hpp"
+#include "LogRenderer.hpp"
+#include "TextIndexFormat.hpp"
+#include "raii/SafeFd.hpp"
+
+struct TextIndexConfig {
+    bool enabled = false;
+    size_t checkpointBytes = 64 * 1024;     // Text covered by one checkpoint
+};
+
+// Builds the "<log>.tix" sidecar of a text sink (see TextIndexFormat.hpp).
+// The sink reports every line it appends, in file order; encoded records
+// are held back until flush(), which the sink calls once the text they
+// describe has been written, so the index never points past the log. A
+// record torn by a crash is cut off before a new session is appended.
+class TextIndexWriter {
+private:
+    static constexpr uint8_t NO_BIT = 0xFF;
+
+    SafeFd file;
+    uint64_t written = 0;                   // Index size, for cutting off torn writes
+    size_t checkpointBytes;
+    std::string pending;                    // Encoded records not yet written
+    TextIndexFormat::Checkpoint current{};
+    std::vector<uint8_t> contextBits;       // By context ID
+    uint8_t nextBit = 0;
+
+    // Cuts the existing index back to its last whole record
+    void repairTail();
+    void put(TextIndexFormat::RecordType type, const void* body, size_t size);
+    uint8_t bitFor(uint16_t contextId);
+    void closeCheckpoint();
+
+public:
+    // dataOffset is the log's size when opened; truncate, or a dataOffset of
+    // 0, restarts the index
+    TextIndexWriter(const std::string& indexPath, uint64_t dataOffset, bool truncate,
+                    size_t checkpointBytes, RenderOptions renderOptions);
+    ~TextIndexWriter();
+
+    TextIndexWriter(const TextIndexWriter&) = delete;
+    TextIndexWriter& operator=(const TextIndexWriter&) = delete;
+
+    void record(const LogMessage& msg, size_t lineBytes);
+    void flush();
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Chunked, newline-splitting reader shared by SafeFile and SafeSocket.
+// Data is pulled from the descriptor in large reads and lines are handed out
+// as string_views into the internal buffer. A view stays valid only until
+// the next call on the reader, so callers copy the lines they keep.
+// A line longer than maxLine is discarded up to its newline and counted, so
+// a peer that never sends '\n' cannot grow the buffer without bound.
+class LineReader {
+    private:
+        std::vector<char> buffer;
+        size_t maxLine;
+        size_t begin = 0;   // First unconsumed byte
+        size_t end = 0;     // One past the last valid byte
+        bool eof = false;
+        bool discarding = false;    // Inside an oversized line, skipping to its '\n'
+        uint64_t dropped = 0;
+
+        // Compacts the buffer and performs a single read(); false if nothing new arrived
+        bool fill(int fd);
+        bool splitLine(std::string_view& line);
+
+    public:
+        static constexpr size_t DEFAULT_CHUNK = 64 * 1024;
+        static constexpr size_t DEFAULT_MAX_LINE = 1024 * 1024;
+
+        explicit LineReader(size_t chunkSize = DEFAULT_CHUNK, size_t maxLine = DEFAULT_MAX_LINE);
+
+        // Next complete line (without '\n'); the final unterminated line is returned at EOF
+        bool nextLine(int fd, std::string_view& line);
+
+        // Every complete line already buffered, refilling only when none is.
+        // False when no line could be produced (EOF, or no data on a non-blocking fd)
+        bool readAvailableLines(int fd, std::vector<std::string_view>& lines);
+
+        bool atEof() const;
+
+        // Lines discarded for exceeding maxLine
+        uint64_t droppedLines() const;
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+// Owns a plain file descriptor for the binary writers and readers (block
+// logs, text index, binary log): EINTR-safe whole writes and positional
+// reads, closed on destruction.
+class SafeFd{
+    private:
+        int fd;
+    public:
+    SafeFd();   // Not open
+    // open(2) flags; O_CLOEXEC is always added
+    SafeFd(const std::string &RefFilePath, int flags, mode_t mode = 0644);
+
+    // Prevent copying the descriptor
+    SafeFd(const SafeFd& other)=delete;
+    SafeFd(SafeFd&& other)noexcept;
+
+    // Prevent copying the descriptor
+    SafeFd &operator=(const SafeFd& other)=delete;
+    SafeFd &operator=(SafeFd&& other)noexcept;
+
+    bool IsOpen() const;
+    int GetFd() const;
+
+    // Loops over short writes; false on the first real error
+    bool WriteAll(const void* data, size_t size);
+    // pread until size bytes arrived; false on error or end of file
+    bool ReadAt(void* out, size_t size, uint64_t offset) const;
+
+    bool Size(uint64_t& size) const;
+    bool Truncate(uint64_t size);
+
+    ~SafeFd();
+};
@@ -1,9 +1,14 @@
 #pragma once
-#include <string>  
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "raii/LineReader.hpp"
 
 class SafeFile{
     private:
         int filefd;
+        LineReader reader;
     public:
     SafeFile()=delete;
     explicit SafeFile(const std::string &RefFilePath);
@@ -20,5 +25,24 @@ class SafeFile{
 
     std::string Read();
 
+    // Zero-copy variants: views point into the internal read buffer and are
+    // only valid until the next read call on this object
+    bool ReadLine(std::string_view& line);
+    bool ReadLines(std::vector<std::string_view>& lines);
+
+    // Whole-file re-read with pread from offset 0, for /proc and sysfs files
+    // that regenerate their content on every read. buffer only grows when
+    // the content does not fit; content points into it.
+    bool Snapshot(std::vector<char>& buffer, std::string_view& content);
+
+    // True once the end of the file was reached and every line handed out
+    bool AtEof() const;
+    // Lines dropped for exceeding LineReader::DEFAULT_MAX_LINE
+    uint64_t DroppedLines() const;
+
+    // Support for event-driven ingestion (e.g. FIFOs)
+    int GetFd() const;
+    bool SetNonBlocking();
+
     ~SafeFile ();
 };
\ No newline at end of file
@@ -1,10 +1,22 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <sys/types.h>
+#include "raii/LineReader.hpp"
+
+struct iovec;
 
 class SafeSocket{
     private:
         int socketfd;
+        LineReader reader;
+
+        // Adopts an already connected/accepted descriptor
+        struct AdoptFd {};
+        SafeSocket(AdoptFd, int fd);
     public:
     SafeSocket()=delete;
     explicit SafeSocket(const std::string &RefFilePath);
@@ -20,6 +32,31 @@ class SafeSocket{
     bool IsOpen();
     std::string Read();
 
+    // Zero-copy variants: views point into the internal read buffer and are
+    // only valid until the next read call on this object
+    bool ReadLine(std::string_view& line);
+    bool ReadLines(std::vector<std::string_view>& lines);
+
+    // True once the peer closed and every buffered line was handed out
+    bool AtEof() const;
+    // Lines dropped for exceeding LineReader::DEFAULT_MAX_LINE
+    uint64_t DroppedLines() const;
+
+    // Support for event-driven ingestion
+    int GetFd() const;
+    bool SetNonBlocking();
+
+    // Listening socket bound to RefFilePath (a stale socket file is replaced)
+    static SafeSocket Listen(const std::string &RefFilePath, int backlog = 64);
+    // Next pending connection; the result is not open if none is waiting
+    SafeSocket Accept();
+
+    // Non-blocking from the start: not open if the peer is absent or its
+    // backlog is full, so callers never wait on connect()
+    static SafeSocket ConnectNonBlocking(const std::string &RefFilePath);
+    // One sendmsg() over the buffers without SIGPIPE; -1 with errno on failure
+    ssize_t SendV(const struct iovec* buffers, int count);
+
     ~SafeSocket();
 
 };
\ No newline at end of file
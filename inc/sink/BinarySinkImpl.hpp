@@ -0,0 +1,37 @@
+#pragma once
+
+#include "sink/ILogSink.hpp"
+#include "raii/SafeFd.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Appends LogMessages as compact length-prefixed records (see
+// logger/BinaryLogFormat.hpp). Text rendering is left to the decoder tool.
+// Reopening an existing file cuts off a record torn by a crash first.
+class BinarySink : public ILogSink {
+    SafeFd file;
+    uint64_t fileSize = 0;              // End of the last whole write
+    std::string buffer;                 // Encoded batch, reused
+    std::string payload;                // Scratch for one record
+    std::vector<bool> knownStrings;     // Dictionary entries already written
+    std::vector<bool> knownPolicies;
+    bool haveTimeBase = false;
+    int64_t lastTimestampNs = 0;
+
+    void beginRecord();
+    void endRecord();
+    void defineString(uint16_t id);
+    void definePolicy(uint8_t id);
+    void encode(const LogMessage& log);
+    void flushBuffer();
+
+public:
+    explicit BinarySink(const std::string& filePath);
+
+    BinarySink(const BinarySink&) = delete;
+    BinarySink& operator=(const BinarySink&) = delete;
+
+    void write(const LogMessage& log) override;
+    void writeBatch(const std::vector<LogMessage>& batch) override;
+};
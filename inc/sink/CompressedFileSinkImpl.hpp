@@ -0,0 +1,90 @@
+#pragma once
+
+#include "sink/ILogSink.hpp"
+#include "logger/LogRenderer.hpp"
+#include "raii/SafeFd.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct CompressedFileSinkConfig {
+    size_t blockBytes = 256 * 1024;                 // Rendered text per block before compression, capped below BlockLogFormat::MAX_RAW_BYTES
+    int compressionLevel = 1;                       // zlib level, 1 = fastest
+    std::chrono::milliseconds flushInterval{1000};  // Seal a partial block after this, 0 = only when full
+    size_t maxPendingBlocks = 4;                    // Sealed blocks waiting for the compressor
+    RenderOptions renderOptions;
+};
+
+struct CompressedFileSinkStats {
+    uint64_t records = 0;
+    uint64_t blocks = 0;
+    uint64_t rawBytes = 0;          // Rendered text written
+    uint64_t storedBytes = 0;       // Block payload bytes on disk
+};
+
+// FileSink output, stored as independently compressed blocks (see
+// logger/BlockLogFormat.hpp) plus a "<path>.idx" index of block offsets and
+// time spans. Rendering happens on the caller's thread; full or aged blocks
+// are handed to a background thread that compresses and appends them, so
+// the LogManager worker only waits when maxPendingBlocks are already queued.
+// Reopening an existing file first repairs what a crash left behind: a torn
+// data tail is cut off, a torn index entry dropped and blocks the index
+// missed are indexed, so the new session appends after whole blocks.
+// Without zlib the blocks are stored uncompressed in the same layout.
+class CompressedFileSink : public ILogSink {
+    struct Block {
+        std::string text;
+        uint32_t records = 0;
+        int64_t firstTimestampNs = 0;
+        int64_t lastTimestampNs = 0;
+    };
+
+    CompressedFileSinkConfig config;
+    LogRenderer renderer;
+    SafeFd dataFile;
+    SafeFd indexFile;
+    uint64_t dataOffset = 0;        // Compressor thread only
+
+    std::thread compressor;
+    std::mutex mtx;
+    Block current;                          // Guarded by mtx, rendered into by the caller
+    std::chrono::steady_clock::time_point currentOpened;
+    std::condition_variable blockReady;     // Compressor waits for sealed or aged blocks
+    std::condition_variable blockDone;      // Caller waits for queue room
+    std::deque<Block> sealed;
+    std::vector<std::string> spareBuffers;  // Text buffers handed back for reuse
+    bool stopping = false;
+    std::string compressed;                 // Compressor scratch
+
+    std::atomic<uint64_t> records{0};
+    std::atomic<uint64_t> blocks{0};
+    std::atomic<uint64_t> rawBytes{0};
+    std::atomic<uint64_t> storedBytes{0};
+
+    void repairTail(uint64_t indexSize);
+    void append(const LogMessage& log, std::unique_lock<std::mutex>& lock);
+    bool currentAged() const;
+    void seal(std::unique_lock<std::mutex>& lock);
+    Block takeCurrent();
+    void compressLoop();
+    void writeBlock(const Block& block);
+
+public:
+    explicit CompressedFileSink(const std::string& filePath, CompressedFileSinkConfig config = {});
+    ~CompressedFileSink() override;
+
+    CompressedFileSink(const CompressedFileSink&) = delete;
+    CompressedFileSink& operator=(const CompressedFileSink&) = delete;
+
+    void write(const LogMessage& log) override;
+    void writeBatch(const std::vector<LogMessage>& batch) override;
+
+    CompressedFileSinkStats getStats() const;
+};
@@ -1,11 +1,18 @@
 #pragma once
 
 #include "sink/ILogSink.hpp"
+#include <string>
+#include "logger/LogRenderer.hpp"
 
 
 
 class ConsoleSink : public ILogSink {
+    LogRenderer renderer;
+    std::string batchBuffer;        // Reused across batches
 public:
+    explicit ConsoleSink(RenderOptions renderOptions = {});
+
     void write(const LogMessage& message) override;
+    void writeBatch(const std::vector<LogMessage>& batch) override;
 };
 
@@ -2,14 +2,26 @@
 
 #include "sink/ILogSink.hpp"
 #include <fstream>
+#include <memory>
+#include <string>
+#include "logger/LogRenderer.hpp"
+#include "logger/TextIndexWriter.hpp"
 
 
 
 class FileSink : public ILogSink {
     std::ofstream file;
+    LogRenderer renderer;
+    std::string batchBuffer;        // Reused across batches
+    std::unique_ptr<TextIndexWriter> index;     // "<path>.tix" when enabled
+
+    void append(const LogMessage& log);
+    void flushBuffer();
 public:
-    FileSink(const std::string& filePath, std::ios::openmode mode = std::ios::app);
+    FileSink(const std::string& filePath, std::ios::openmode mode = std::ios::app,
+             RenderOptions renderOptions = {}, TextIndexConfig indexConfig = {});
     ~FileSink() = default;
 
     void write(const LogMessage& log) override; 
-};
\ No newline at end of file
+    void writeBatch(const std::vector<LogMessage>& batch) override;
+};
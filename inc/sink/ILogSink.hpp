@@ -1,11 +1,65 @@
 #pragma once
+#include <functional>
+#include <vector>
 #include "logger/LogMessage.hpp"
+#include "logger/SeverityFilter.hpp"
 
 
 //BaseSink
 
 class ILogSink { 
+private:
+    // LogManager drops messages below this before they reach the sink
+    SeverityFilter minSeverity;
+    std::function<void()> thresholdListener;
+
 public:
     virtual void write(const LogMessage& message) = 0;
+
+    // Called by LogManager with every message drained in one wakeup.
+    // Sinks that can coalesce output should override this; the default
+    // simply forwards each message to write().
+    virtual void writeBatch(const std::vector<LogMessage>& batch) {
+        for (const auto& message : batch) {
+            write(message);
+        }
+    }
+
+    // Used by LogManager: forwards only the messages at or above the sink's
+    // threshold, copying them into scratch when some must be left out.
+    // Returns what was written (batch or scratch), empty if nothing was.
+    const std::vector<LogMessage>& deliverBatch(const std::vector<LogMessage>& batch,
+                                                std::vector<LogMessage>& scratch) {
+        if (minSeverity.getMinSeverity() == LogType::INFO) {
+            if (!batch.empty()) {
+                writeBatch(batch);
+            }
+            return batch;
+        }
+        scratch.clear();
+        for (const auto& message : batch) {
+            if (minSeverity.allows(message.getSeverity())) {
+                scratch.push_back(message);
+            }
+        }
+        if (!scratch.empty()) {
+            writeBatch(scratch);
+        }
+        return scratch;
+    }
+
+    void setMinSeverity(LogType level) {
+        minSeverity.setMinSeverity(level);
+        if (thresholdListener) {
+            thresholdListener();
+        }
+    }
+    LogType getMinSeverity() const { return minSeverity.getMinSeverity(); }
+    bool accepts(LogType level) const { return minSeverity.allows(level); }
+
+    // Set by LogManager::addSink, so a level no sink accepts is rejected in
+    // addLog (and by bound formatters) instead of on the consumer
+    void setThresholdListener(std::function<void()> listener) { thresholdListener = std::move(listener); }
+
     virtual ~ILogSink() = default;
-};
\ No newline at end of file
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "sink/ILogSink.hpp"
+#include "logger/LogRenderer.hpp"
+#include "enums/SyncPolicy.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+struct MappedFileSinkConfig {
+    size_t segmentBytes = 64 * 1024 * 1024;         // Preallocated size of each segment
+    std::chrono::seconds rotateInterval{0};         // 0 = rotate on size only
+    SyncPolicy_enum syncPolicy = SyncPolicy_enum::NONE;
+    std::chrono::milliseconds syncInterval{1000};   // SyncPolicy_enum::INTERVAL
+    size_t syncBytes = 1024 * 1024;                 // SyncPolicy_enum::BYTES
+    std::chrono::milliseconds retryMin{10};         // After a failed rotation, doubled per failure
+    std::chrono::milliseconds retryMax{1000};
+    RenderOptions renderOptions;
+};
+
+struct MappedFileSinkStats {
+    uint64_t segments = 0;          // Segments opened, the first one included
+    uint64_t failedOpens = 0;       // Rotations (or retries) that could not map a segment
+    uint64_t dropped = 0;           // Lines lost: no segment mapped, or longer than a segment
+};
+
+// Writes rendered lines into a fallocate'd + mmap'ed segment file named
+// "<basePath>.<N>". Segments rotate by size or age and are truncated to
+// their used length when closed, so only the live segment carries padding.
+// If a new segment cannot be mapped, lines are dropped and counted while the
+// open is retried with exponential backoff on later writes.
+class MappedFileSink : public ILogSink {
+    std::string basePath;
+    MappedFileSinkConfig config;
+    LogRenderer renderer;
+    std::string line;               // A line that has to wait for the next segment
+
+    int fd = -1;
+    char* mapping = nullptr;
+    size_t used = 0;                // Bytes written into the live segment
+    size_t syncedUpTo = 0;          // Prefix of the segment already msync'ed
+    size_t segmentIndex = 0;
+    std::chrono::steady_clock::time_point segmentOpened;
+    std::chrono::steady_clock::time_point lastSync;
+    std::chrono::steady_clock::time_point nextRetry;
+    std::chrono::milliseconds retryDelay;
+
+    std::atomic<uint64_t> segments{0};
+    std::atomic<uint64_t> failedOpens{0};
+    std::atomic<uint64_t> dropped{0};
+
+    bool openSegment();
+    void closeSegment();
+    bool rotate();
+    // Without a mapping: reopens the segment once the backoff has passed
+    bool ensureMapped();
+    void rotateIfExpired();
+    void sync();
+    void append(const LogMessage& log);
+    void applySyncPolicy(bool sawError);
+
+public:
+    explicit MappedFileSink(const std::string& basePath, MappedFileSinkConfig config = {});
+    ~MappedFileSink() override;
+
+    MappedFileSink(const MappedFileSink&) = delete;
+    MappedFileSink& operator=(const MappedFileSink&) = delete;
+
+    void write(const LogMessage& log) override;
+    void writeBatch(const std::vector<LogMessage>& batch) override;
+
+    // Path of the segment currently being written
+    std::string currentSegmentPath() const;
+
+    MappedFileSinkStats getStats() const;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "sink/ILogSink.hpp"
+#include "logger/LogRenderer.hpp"
+#include "raii/SafeSocket.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+struct SocketSinkConfig {
+    size_t retryBufferBytes = 4 * 1024 * 1024;      // Unsent text kept while the peer is slow or gone
+    std::chrono::milliseconds reconnectMin{100};    // First backoff step, doubled per failure
+    std::chrono::milliseconds reconnectMax{5000};
+    RenderOptions renderOptions;
+};
+
+struct SocketSinkStats {
+    uint64_t bytesSent = 0;
+    uint64_t recordsDropped = 0;    // Evicted from the retry buffer or cut by a disconnect
+    uint64_t reconnects = 0;        // Successful connects after the first one
+    uint64_t connectFailures = 0;
+    size_t bufferedBytes = 0;
+    bool connected = false;
+};
+
+// Ships rendered lines to a local collector over a non-blocking AF_UNIX
+// stream socket. Each batch is rendered into one buffer and sent together
+// with whatever is still pending in a single sendmsg(); the unsent tail is
+// kept in a bounded retry buffer, oldest whole lines are dropped first.
+// Connecting never blocks the calling thread: a missing collector is
+// retried with exponential backoff on later batches.
+class SocketSink : public ILogSink {
+    std::string path;
+    SocketSinkConfig config;
+    LogRenderer renderer;
+
+    std::unique_ptr<SafeSocket> socket;     // Null while disconnected
+    bool everConnected = false;
+    std::chrono::steady_clock::time_point nextAttempt;
+    std::chrono::milliseconds backoff;
+
+    std::string batchBuffer;        // Current batch, reused
+    std::string pending;            // Retry buffer, pendingOffset bytes already sent
+    size_t pendingOffset = 0;
+
+    std::atomic<uint64_t> bytesSent{0};
+    std::atomic<uint64_t> recordsDropped{0};
+    std::atomic<uint64_t> reconnects{0};
+    std::atomic<uint64_t> connectFailures{0};
+    std::atomic<size_t> bufferedBytes{0};
+    std::atomic<bool> connected{false};
+
+    void tryConnect();
+    void disconnect();
+    void ship();
+    void dropPartialRecord();
+    void trimPending();
+
+public:
+    explicit SocketSink(const std::string& socketPath, SocketSinkConfig config = {});
+    ~SocketSink() override = default;
+
+    SocketSink(const SocketSink&) = delete;
+    SocketSink& operator=(const SocketSink&) = delete;
+
+    void write(const LogMessage& log) override;
+    void writeBatch(const std::vector<LogMessage>& batch) override;
+
+    SocketSinkStats getStats() const;
+};
@@ -13,6 +13,7 @@ class FileTelemetrySourceImpl: public ITelemetrySource{
         explicit FileTelemetrySourceImpl(const std::string& path);
         bool openSource() override;
         bool readSource(std::string& out) override;
+        bool readSourceBatch(std::vector<std::string_view>& out) override;
 
        ~FileTelemetrySourceImpl() override = default;
 };
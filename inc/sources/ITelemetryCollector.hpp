@@ -0,0 +1,15 @@
+#pragma once
+#include <chrono>
+
+// A source that is sampled on demand rather than read as a stream, usually
+// driven by SamplingScheduler. collect() formats its readings itself and
+// queues them on a LogManager; it runs on the scheduler thread only.
+class ITelemetryCollector {
+public:
+    virtual bool open() = 0;
+
+    // False if the sample could not be taken; the collector stays scheduled
+    virtual bool collect(std::chrono::system_clock::time_point now) = 0;
+
+    virtual ~ITelemetryCollector() = default;
+};
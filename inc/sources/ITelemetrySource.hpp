@@ -1,10 +1,17 @@
 #pragma once
 #include <string>
+#include <string_view>
+#include <vector>
 
 class ITelemetrySource{
     private:
     public:
         virtual bool openSource()=0;
         virtual bool readSource(std::string& out) = 0;
+
+        // Bulk read: every sample currently buffered by the source. The views
+        // are only valid until the next read call on the same source.
+        virtual bool readSourceBatch(std::vector<std::string_view>& out) = 0;
+
         virtual ~ITelemetrySource()=default;
-};
\ No newline at end of file
+};
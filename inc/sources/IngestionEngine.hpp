@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "raii/SafeFile.hpp"
+#include "raii/SafeSocket.hpp"
+#include "logger/LogManager.hpp"
+#include "formatter/LogFormatter.hpp"
+
+// Receives every complete line read from a source, on an engine thread
+using LineHandler = std::function<void(std::string_view line)>;
+
+struct IngestionStats {
+    uint64_t linesRead = 0;
+    uint64_t linesRejected = 0;     // Handler-reported parse failures (see route())
+    uint64_t linesFiltered = 0;     // Valid lines below the formatter's severity threshold
+    uint64_t linesTooLong = 0;      // Dropped by the line readers (LineReader::DEFAULT_MAX_LINE)
+    uint64_t connectionsAccepted = 0;
+    uint64_t sourcesClosed = 0;
+    size_t activeSources = 0;
+};
+
+// Multiplexes many telemetry sources over a few epoll threads instead of one
+// blocking thread per ITelemetrySource. Descriptors are switched to
+// non-blocking mode, read in chunks through the SafeSocket/SafeFile line
+// readers and every complete line is passed to the handler of its source.
+// Listening sockets accept new feeders, which inherit the listener's handler.
+class IngestionEngine {
+private:
+    enum class SourceKind { LISTENER, SOCKET, FILE };
+
+    struct Source {
+        SourceKind kind;
+        std::unique_ptr<SafeSocket> socket;
+        std::unique_ptr<SafeFile> file;
+        std::shared_ptr<LineHandler> handler;
+        int fd;
+        uint64_t droppedLines = 0;          // Reader count already added to linesTooLong
+    };
+
+    struct Loop {
+        int epollFd = -1;
+        int wakeFd = -1;                    // eventfd used by stop()
+        std::thread thread;
+        std::mutex mtx;                     // Guards sources/polled against add*()
+        std::unordered_map<Source*, std::unique_ptr<Source>> sources;
+        std::vector<Source*> polled;        // Regular files: epoll cannot watch them
+    };
+
+    std::vector<std::unique_ptr<Loop>> loops;
+    std::atomic<size_t> nextLoop{0};
+    std::atomic<bool> running{false};
+
+    std::atomic<uint64_t> linesRead{0};
+    std::atomic<uint64_t> linesRejected{0};
+    std::atomic<uint64_t> linesFiltered{0};
+    std::atomic<uint64_t> linesTooLong{0};
+    std::atomic<uint64_t> connectionsAccepted{0};
+    std::atomic<uint64_t> sourcesClosed{0};
+    std::atomic<int64_t> activeSources{0};
+
+    bool registerSource(std::unique_ptr<Source> source, Loop* loop = nullptr);
+    void closeSource(Loop& loop, Source* source);
+    void run(Loop& loop);
+    void acceptAll(Source& listener);
+    // False once the source is exhausted and must be closed
+    bool drain(Source& source, std::vector<std::string_view>& lines);
+
+public:
+    explicit IngestionEngine(size_t threadCount = 1);
+    ~IngestionEngine();
+
+    IngestionEngine(const IngestionEngine&) = delete;
+    IngestionEngine& operator=(const IngestionEngine&) = delete;
+
+    // Sources may be added before or after start()
+    bool addSocket(const std::string& path, LineHandler handler);
+    bool addFile(const std::string& path, LineHandler handler);
+    bool listen(const std::string& path, LineHandler handler);
+
+    void start();
+    void stop();
+
+    IngestionStats getStats() const;
+
+    // Handler that parses each line with the formatter and queues it on the
+    // manager; lines the formatter rejects or filters are counted separately
+    template <typename Policy, LogType MinLevel>
+    LineHandler route(const LogFormatter<Policy, MinLevel>& formatter, LogManager& manager) {
+        return [this, &formatter, &manager](std::string_view line) {
+            LogMessage logMsg;
+            switch (formatter.tryFormat(line, logMsg)) {
+                case FormatStatus_enum::ACCEPTED:
+                    manager.addLog(std::move(logMsg));
+                    break;
+                case FormatStatus_enum::FILTERED:
+                    linesFiltered.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                default:
+                    linesRejected.fetch_add(1, std::memory_order_relaxed);
+                    break;
+            }
+        };
+    }
+};
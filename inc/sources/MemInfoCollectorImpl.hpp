@@ -0,0 +1,30 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "ITelemetryCollector.hpp"
+#include "raii/SafeFile.hpp"
+#include "logger/LogManager.hpp"
+#include "formatter/LogFormatter.hpp"
+#include "formatter/policies/RamPolicy.hpp"
+
+// Memory pressure from /proc/meminfo as "RAM_USAGE": the share of MemTotal
+// that is not MemAvailable (page cache the kernel can drop counts as free).
+// Same open-once, pread-from-zero and allocation-free parsing as
+// ProcStatCollectorImpl.
+class MemInfoCollectorImpl : public ITelemetryCollector {
+private:
+    LogManager& manager;
+    std::string path;
+    std::unique_ptr<SafeFile> file;
+    std::vector<char> buffer;
+    LogFormatter<RamPolicy> formatter;
+
+public:
+    explicit MemInfoCollectorImpl(LogManager& manager, const std::string& app = "localhost",
+                                  const std::string& path = "/proc/meminfo");
+
+    bool open() override;
+    bool collect(std::chrono::system_clock::time_point now) override;
+};
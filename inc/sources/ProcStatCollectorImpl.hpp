@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ITelemetryCollector.hpp"
+#include "raii/SafeFile.hpp"
+#include "logger/LogManager.hpp"
+#include "formatter/LogFormatter.hpp"
+#include "formatter/policies/CpuPolicy.hpp"
+
+// CPU utilisation from /proc/stat: the busy share of the jiffies that passed
+// since the previous sample, for the whole machine ("CPU_LOAD") and, with
+// perCore, for every core ("CPU_CORE_<n>"). The file stays open and is
+// re-read from offset 0; parsing stops at the first non-"cpu" line and does
+// not allocate once every core has been seen. A core whose counters did not
+// move since the last sample (intervals below one jiffy) keeps its baseline
+// and is reported once they do.
+class ProcStatCollectorImpl : public ITelemetryCollector {
+private:
+    struct CpuTimes {
+        uint64_t busy = 0;
+        uint64_t total = 0;
+        bool valid = false;
+    };
+
+    LogManager& manager;
+    std::string app;
+    std::string path;
+    bool perCore;
+    std::unique_ptr<SafeFile> file;
+    std::vector<char> buffer;
+
+    LogFormatter<CpuPolicy> totalFormatter;
+    CpuTimes totalPrevious;
+    std::vector<LogFormatter<CpuPolicy>> coreFormatters;   // By core number
+    std::vector<CpuTimes> corePrevious;
+
+    static bool parseTimes(std::string_view fields, CpuTimes& times);
+    void report(const LogFormatter<CpuPolicy>& formatter, CpuTimes& previous, const CpuTimes& current,
+                std::chrono::system_clock::time_point now);
+
+public:
+    explicit ProcStatCollectorImpl(LogManager& manager, const std::string& app = "localhost",
+                                   bool perCore = true, const std::string& path = "/proc/stat");
+
+    bool open() override;
+    bool collect(std::chrono::system_clock::time_point now) override;
+};
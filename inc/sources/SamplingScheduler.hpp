@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ITelemetryCollector.hpp"
+
+struct SamplingStats {
+    uint64_t samples = 0;
+    uint64_t failures = 0;          // collect() returned false
+    uint64_t overruns = 0;          // Ticks still being handled when the next one was due
+    uint64_t collectNs = 0;         // Time spent inside collect()
+    size_t collectors = 0;
+};
+
+// Drives many collectors at different intervals from one thread. Timers sit
+// in a hashed timing wheel of WHEEL_SLOTS slots, one per tick; intervals
+// longer than a turn carry a round count. The thread sleeps until the next
+// occupied slot instead of waking on every tick, and every timer is
+// re-armed from its scheduled slot, so intervals do not drift with the time
+// spent collecting.
+//
+// The wheel belongs to the scheduler thread, so a wakeup takes no lock: it
+// finds the next slot in an occupancy bitmap and sleeps on a futex with an
+// absolute deadline. add() and stop() hand over through mtx and bump the
+// futex word to cut the sleep short.
+class SamplingScheduler {
+private:
+    static constexpr size_t WHEEL_SLOTS = 256;
+    static constexpr size_t WORD_BITS = 64;
+
+    struct Timer {
+        ITelemetryCollector* collector;
+        uint64_t intervalTicks;
+        uint64_t rounds;
+    };
+
+    // Scheduler thread only (and start() before the thread exists)
+    std::chrono::steady_clock::duration tick;
+    std::vector<std::vector<Timer>> wheel;
+    std::array<uint64_t, WHEEL_SLOTS / WORD_BITS> occupied{};  // One bit per non-empty slot
+    size_t cursor = 0;                                  // Slot last processed
+    std::chrono::steady_clock::time_point cursorTime;   // When that slot was due
+    std::vector<Timer> due;                             // Scratch
+
+    std::thread thread;
+    mutable std::mutex mtx;         // Guards collectors, added and running
+    std::vector<std::unique_ptr<ITelemetryCollector>> collectors;
+    std::vector<Timer> added;       // Not yet on the wheel
+    bool running = false;
+    std::atomic<bool> pendingAdds{false};
+    std::atomic<bool> stopping{false};
+    std::atomic<uint32_t> signal{0};    // Futex word, bumped by add() and stop()
+
+    std::atomic<uint64_t> samples{0};
+    std::atomic<uint64_t> failures{0};
+    std::atomic<uint64_t> overruns{0};
+    std::atomic<uint64_t> collectNs{0};
+
+    void arm(const Timer& timer, uint64_t delayTicks);
+    void armAdded();
+    size_t ticksToNextTimer() const;
+    void wake();
+    void run();
+
+public:
+    explicit SamplingScheduler(std::chrono::milliseconds tick = std::chrono::milliseconds(1));
+    ~SamplingScheduler();
+
+    SamplingScheduler(const SamplingScheduler&) = delete;
+    SamplingScheduler& operator=(const SamplingScheduler&) = delete;
+
+    // Opens the collector and samples it every interval (rounded to ticks);
+    // false if it cannot be opened. Allowed before or after start()
+    bool add(std::unique_ptr<ITelemetryCollector> collector, std::chrono::milliseconds interval);
+
+    void start();
+    void stop();
+
+    SamplingStats getStats() const;
+};
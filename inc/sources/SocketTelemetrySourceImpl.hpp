@@ -14,6 +14,7 @@ class SocketTelemetrySourceImpl: public ITelemetrySource{
         explicit SocketTelemetrySourceImpl(const std::string &path);
         bool openSource() override;
         bool readSource(std::string& out) override;
+        bool readSourceBatch(std::vector<std::string_view>& out) override;
         ~SocketTelemetrySourceImpl()=default;
 
 };
\ No newline at end of file
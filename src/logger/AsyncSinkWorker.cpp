@@ -0,0 +1,154 @@
+#include "logger/AsyncSinkWorker.hpp"
+
+namespace {
+    constexpr int MAX_EVICT_ATTEMPTS = 8;
+}
+
+AsyncSinkWorker::AsyncSinkWorker(std::unique_ptr<ILogSink> sink, const SinkQueueConfig& config, bool timed)
+    : sink(std::move(sink)), overflow(config.overflow), queue(config.depth), timed(timed) {
+    workerThread = std::thread(&AsyncSinkWorker::processLoop, this);
+}
+
+bool AsyncSinkWorker::tryPushCounted(Entry& entry) {
+    // Counted up front so a fast consumer never sees the depth go negative
+    queuedBatches.fetch_add(1, std::memory_order_relaxed);
+    if (queue.tryPush(std::move(entry))) {
+        return true;
+    }
+    queuedBatches.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool AsyncSinkWorker::push(Entry& entry) {
+    if (tryPushCounted(entry)) {
+        // Lock so the notification cannot fall between the worker's check and its wait
+        std::lock_guard<std::mutex> lock(mtx);
+        dataCv.notify_one();
+        return true;
+    }
+    return false;
+}
+
+void AsyncSinkWorker::countDrop(const SharedBatch& batch) {
+    droppedBatches.fetch_add(1, std::memory_order_relaxed);
+    droppedMessages.fetch_add(batch ? batch->size() : 0, std::memory_order_relaxed);
+}
+
+void AsyncSinkWorker::enqueue(const SharedBatch& batch) {
+    Entry entry{batch, std::chrono::steady_clock::now()};
+    if (push(entry)) {
+        return;
+    }
+
+    switch (overflow.policy) {
+        case OverflowPolicy_enum::DROP_OLDEST:
+            for (int attempt = 0; attempt < MAX_EVICT_ATTEMPTS; ++attempt) {
+                if (auto evicted = queue.tryPop()) {
+                    queuedBatches.fetch_sub(1, std::memory_order_relaxed);
+                    countDrop(evicted->batch);
+                }
+                if (push(entry)) {
+                    return;
+                }
+            }
+            countDrop(batch);
+            break;
+
+        case OverflowPolicy_enum::SPIN_THEN_BLOCK:
+            for (size_t i = 0; i < overflow.spinIterations; ++i) {
+                if (push(entry)) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+            [[fallthrough]];
+
+        case OverflowPolicy_enum::BLOCK_WITH_TIMEOUT: {
+            bool pushed = false;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                spaceCv.wait_for(lock, overflow.blockTimeout, [this, &entry, &pushed] {
+                    pushed = tryPushCounted(entry);
+                    return pushed || stopFlag.load();
+                });
+                if (pushed) {
+                    dataCv.notify_one();
+                }
+            }
+            if (!pushed) {
+                countDrop(batch);
+            }
+            break;
+        }
+
+        default:
+            countDrop(batch);
+            break;
+    }
+}
+
+void AsyncSinkWorker::processLoop() {
+    std::vector<LogMessage> filtered;   // Reused when the sink has a severity threshold
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            dataCv.wait(lock, [this] {
+                return stopFlag.load() || !queue.isEmpty();
+            });
+            if (stopFlag.load() && queue.isEmpty()) {
+                break;
+            }
+        }
+
+        while (auto entry = queue.tryPop()) {
+            queuedBatches.fetch_sub(1, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                spaceCv.notify_one();
+            }
+
+            if (sink && entry->batch) {
+                auto start = std::chrono::steady_clock::now();
+                const auto& written = sink->deliverBatch(*entry->batch, filtered);
+                if (timed) {
+                    timings.recordBatch(written, start);
+                }
+            }
+
+            auto lag = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - entry->enqueued).count();
+            uint64_t lagUs = static_cast<uint64_t>(lag);
+            lastLagUs.store(lagUs, std::memory_order_relaxed);
+            if (lagUs > maxLagUs.load(std::memory_order_relaxed)) {
+                maxLagUs.store(lagUs, std::memory_order_relaxed);
+            }
+            batchesWritten.fetch_add(1, std::memory_order_relaxed);
+            messagesWritten.fetch_add(entry->batch ? entry->batch->size() : 0, std::memory_order_relaxed);
+        }
+    }
+}
+
+SinkLagStats AsyncSinkWorker::getStats() const {
+    SinkLagStats stats;
+    stats.batchesWritten = batchesWritten.load(std::memory_order_relaxed);
+    stats.messagesWritten = messagesWritten.load(std::memory_order_relaxed);
+    stats.droppedBatches = droppedBatches.load(std::memory_order_relaxed);
+    stats.droppedMessages = droppedMessages.load(std::memory_order_relaxed);
+    stats.lastLagUs = lastLagUs.load(std::memory_order_relaxed);
+    stats.maxLagUs = maxLagUs.load(std::memory_order_relaxed);
+    int64_t queued = queuedBatches.load(std::memory_order_relaxed);
+    stats.queuedBatches = queued > 0 ? static_cast<size_t>(queued) : 0;
+    return stats;
+}
+
+AsyncSinkWorker::~AsyncSinkWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopFlag = true;
+        dataCv.notify_all();
+        spaceCv.notify_all();
+    }
+    if (workerThread.joinable()) {
+        workerThread.join();
+    }
+}
@@ -0,0 +1,33 @@
+#include "logger/BatchPool.hpp"
+
+BatchPool::BatchPool(size_t batchCapacity, size_t maxSlots)
+    : batchCapacity(batchCapacity), maxSlots(maxSlots) {}
+
+SharedBatch BatchPool::acquire(const std::vector<LogMessage>& messages) {
+    // Workers release batches roughly in order, so start after the last hit
+    for (size_t i = 0; i < slots.size(); ++i) {
+        size_t index = (nextSlot + i) % slots.size();
+        auto& slot = slots[index];
+        if (slot.use_count() == 1) {
+            // Pairs with the release in the workers' shared_ptr destructor
+            std::atomic_thread_fence(std::memory_order_acquire);
+            slot->assign(messages.begin(), messages.end());
+            nextSlot = index + 1;
+            reused.fetch_add(1, std::memory_order_relaxed);
+            return slot;
+        }
+    }
+
+    allocated.fetch_add(1, std::memory_order_relaxed);
+    if (slots.size() >= maxSlots.load(std::memory_order_relaxed)) {
+        // Every slot is still queued somewhere: fall back to a one-off batch
+        return std::make_shared<const std::vector<LogMessage>>(messages);
+    }
+    auto slot = std::make_shared<std::vector<LogMessage>>();
+    slot->reserve(batchCapacity > messages.size() ? batchCapacity : messages.size());
+    slot->assign(messages.begin(), messages.end());
+    slots.push_back(slot);
+    slotsUsed.store(slots.size(), std::memory_order_relaxed);
+    nextSlot = slots.size();
+    return slot;
+}
@@ -0,0 +1,151 @@
+#include "logger/BinaryLogReader.hpp"
+#include "logger/BinaryLogFormat.hpp"
+#include "logger/StringRegistry.hpp"
+#include "logger/PolicyRegistry.hpp"
+
+using namespace BinaryLogFormat;
+
+BinaryLogReader::BinaryLogReader(const std::string& filePath)
+    : file(filePath, std::ios::binary), policyIds(PolicyRegistry::MAX_POLICIES, PolicyRegistry::GENERIC_ID) {
+    char header[HEADER_SIZE];
+    if (file.read(header, HEADER_SIZE)) {
+        uint16_t version;
+        std::memcpy(&version, header + sizeof(MAGIC), sizeof(version));
+        valid = std::memcmp(header, MAGIC, sizeof(MAGIC)) == 0 && version == VERSION;
+    }
+}
+
+bool BinaryLogReader::isValid() const {
+    return valid;
+}
+
+uint64_t BinaryLogReader::skippedRecords() const {
+    return corruptRecords;
+}
+
+bool BinaryLogReader::readVarint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = file.get();
+        if (byte == std::char_traits<char>::eof()) {
+            return false;
+        }
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BinaryLogReader::applyRecord(LogMessage& out, bool& isLog) {
+    Reader in{payload.data(), payload.data() + payload.size()};
+    uint8_t type;
+    if (!in.fixed(type)) {
+        return false;
+    }
+
+    isLog = false;
+    switch (static_cast<RecordType>(type)) {
+        case RecordType::TIME_BASE: {
+            int64_t base;
+            if (!in.fixed(base)) {
+                return false;
+            }
+            lastTimestampNs = base;
+            return true;
+        }
+        case RecordType::STRING: {
+            uint64_t id, length;
+            std::string text;
+            if (!in.varint(id) || !in.varint(length) || !in.bytes(text, length) || id >= StringRegistry::INVALID_ID) {
+                return false;
+            }
+            if (id >= stringIds.size()) {
+                stringIds.resize(id + 1, StringRegistry::INVALID_ID);
+            }
+            stringIds[id] = StringRegistry::intern(text);
+            return true;
+        }
+        case RecordType::POLICY: {
+            uint8_t id;
+            uint64_t length;
+            std::string unit;
+            if (!in.fixed(id) || !in.varint(length) || !in.bytes(unit, length)) {
+                return false;
+            }
+            uint8_t precision = MessageTemplate::DEFAULT_PRECISION;
+            std::string messageTemplate(MessageTemplate::DEFAULT_TEXT);
+            if (!in.atEnd() && (!in.fixed(precision) || !in.varint(length) || !in.bytes(messageTemplate, length))) {
+                return false;
+            }
+            policyIds[id] = PolicyRegistry::define(unit, messageTemplate, precision);
+            return true;
+        }
+        case RecordType::LOG:
+        case RecordType::AGGREGATE: {
+            uint64_t delta, app, context;
+            uint8_t severity, policy;
+            float value;
+            if (!in.varint(delta) || !in.fixed(severity) || !in.varint(app) || !in.varint(context) ||
+                !in.fixed(policy) || !in.fixed(value)) {
+                return false;
+            }
+            lastTimestampNs += unzigzag(delta);
+
+            auto localString = [this](uint64_t id) {
+                return id < stringIds.size() ? stringIds[id] : StringRegistry::INVALID_ID;
+            };
+            out = LogMessage(localString(app), localString(context), policyIds[policy],
+                             static_cast<LogType>(severity), value,
+                             std::chrono::system_clock::time_point(
+                                 std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                                     std::chrono::nanoseconds(lastTimestampNs))));
+            if (static_cast<RecordType>(type) == RecordType::AGGREGATE) {
+                uint8_t kind;
+                uint64_t count;
+                float minValue, maxValue, meanValue;
+                if (!in.fixed(kind) || !in.varint(count) || !in.fixed(minValue) ||
+                    !in.fixed(maxValue) || !in.fixed(meanValue)) {
+                    return false;
+                }
+                out = static_cast<LogKind>(kind) == LogKind::REPEAT
+                    ? LogMessage::repeat(out, static_cast<uint32_t>(count))
+                    : LogMessage::summary(out, static_cast<uint32_t>(count), minValue, maxValue, meanValue);
+            }
+            isLog = true;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+bool BinaryLogReader::next(LogMessage& out) {
+    if (!valid) {
+        return false;
+    }
+
+    uint64_t length;
+    while (readVarint(length)) {
+        if (length > MAX_RECORD_BYTES) {
+            // The framing is lost, nothing after this can be trusted
+            ++corruptRecords;
+            return false;
+        }
+        payload.resize(length);
+        if (!file.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(length))) {
+            return false; // Truncated tail, e.g. writer still running
+        }
+
+        bool isLog = false;
+        if (!applyRecord(out, isLog)) {
+            ++corruptRecords;
+            continue;
+        }
+        if (isLog) {
+            return true;
+        }
+    }
+    return false;
+}
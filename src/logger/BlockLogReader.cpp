@@ -0,0 +1,121 @@
+#include "logger/BlockLogReader.hpp"
+#include <fcntl.h>
+#include <cstring>
+#ifdef TELELOG_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace BlockLogFormat;
+
+BlockLogReader::BlockLogReader(const std::string& filePath) : file(filePath, O_RDONLY) {
+    char magic[MAGIC_SIZE];
+    if (!file.Size(fileSize) || !file.ReadAt(magic, MAGIC_SIZE, 0) ||
+        std::memcmp(magic, DATA_MAGIC, MAGIC_SIZE) != 0) {
+        fileSize = 0;
+        return;
+    }
+    valid = true;
+
+    loadIndex(filePath + INDEX_SUFFIX);
+    uint64_t indexed = MAGIC_SIZE;
+    if (!entries.empty()) {
+        const IndexEntry& last = entries.back();
+        indexed = last.offset + sizeof(BlockHeader) + last.header.storedBytes;
+    }
+    size_t before = entries.size();
+    scanFrom(indexed);
+    recovered = entries.size() - before;
+}
+
+void BlockLogReader::loadIndex(const std::string& indexPath) {
+    SafeFd index(indexPath, O_RDONLY);
+    uint64_t indexSize = 0;
+    char magic[MAGIC_SIZE];
+    if (index.Size(indexSize) && indexSize >= MAGIC_SIZE && index.ReadAt(magic, MAGIC_SIZE, 0) &&
+        std::memcmp(magic, INDEX_MAGIC, MAGIC_SIZE) == 0) {
+        // A torn trailing entry is ignored; the scan picks its block up again
+        size_t count = static_cast<size_t>(indexSize - MAGIC_SIZE) / sizeof(IndexEntry);
+        entries.resize(count);
+        if (count > 0 && !index.ReadAt(entries.data(), count * sizeof(IndexEntry), MAGIC_SIZE)) {
+            entries.clear();
+        }
+        // Entries must describe whole blocks, in file order, inside the data
+        // file; everything from the first one that does not (a torn entry,
+        // or one misaligned behind it) is dropped and found again by the scan
+        uint64_t expected = MAGIC_SIZE;
+        size_t good = 0;
+        for (; good < entries.size(); ++good) {
+            const IndexEntry& entry = entries[good];
+            if (entry.offset < expected || !plausible(entry.header) ||
+                entry.offset + sizeof(BlockHeader) + entry.header.storedBytes > fileSize) {
+                break;
+            }
+            expected = entry.offset + sizeof(BlockHeader) + entry.header.storedBytes;
+        }
+        entries.resize(good);
+    }
+}
+
+void BlockLogReader::scanFrom(uint64_t offset) {
+    BlockHeader header;
+    while (offset + sizeof(header) <= fileSize && file.ReadAt(&header, sizeof(header), offset)) {
+        if (!plausible(header) || offset + sizeof(header) + header.storedBytes > fileSize) {
+            break; // Block still being written, or torn
+        }
+        entries.push_back(IndexEntry{offset, header});
+        offset += sizeof(header) + header.storedBytes;
+    }
+}
+
+bool BlockLogReader::isValid() const {
+    return valid;
+}
+
+const std::vector<IndexEntry>& BlockLogReader::blocks() const {
+    return entries;
+}
+
+std::vector<size_t> BlockLogReader::overlapping(int64_t fromNs, int64_t toNs) const {
+    std::vector<size_t> result;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const BlockHeader& header = entries[i].header;
+        if (header.lastTimestampNs >= fromNs && header.firstTimestampNs <= toNs) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+bool BlockLogReader::readBlock(const IndexEntry& entry, std::string& text) {
+    uint64_t payloadOffset = entry.offset + sizeof(BlockHeader);
+    // Bounds both allocations below
+    if (!plausible(entry.header)) {
+        return false;
+    }
+    switch (static_cast<BlockCodec>(entry.header.codec)) {
+        case BlockCodec::STORED:
+            text.resize(entry.header.storedBytes);
+            return file.ReadAt(text.data(), text.size(), payloadOffset);
+
+#ifdef TELELOG_HAVE_ZLIB
+        case BlockCodec::DEFLATE: {
+            compressed.resize(entry.header.storedBytes);
+            if (!file.ReadAt(compressed.data(), compressed.size(), payloadOffset)) {
+                return false;
+            }
+            text.resize(entry.header.rawBytes);
+            uLongf rawSize = entry.header.rawBytes;
+            int status = uncompress(reinterpret_cast<Bytef*>(text.data()), &rawSize,
+                                    reinterpret_cast<const Bytef*>(compressed.data()),
+                                    static_cast<uLong>(compressed.size()));
+            return status == Z_OK && rawSize == entry.header.rawBytes;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+size_t BlockLogReader::recoveredBlocks() const {
+    return recovered;
+}
@@ -0,0 +1,137 @@
+#include "logger/LogAggregator.hpp"
+#include <limits>
+
+void LogAggregator::enable(uint16_t appId, uint16_t contextId, const AggregationConfig& config) {
+    std::lock_guard<std::mutex> lock(pendingMtx);
+    pendingEnable.emplace_back(keyOf(appId, contextId), config);
+    hasPending.store(true, std::memory_order_release);
+}
+
+void LogAggregator::disable(uint16_t appId, uint16_t contextId) {
+    std::lock_guard<std::mutex> lock(pendingMtx);
+    pendingDisable.push_back(keyOf(appId, contextId));
+    hasPending.store(true, std::memory_order_release);
+}
+
+void LogAggregator::applyPending(std::vector<LogMessage>& out) {
+    if (!hasPending.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(pendingMtx);
+    for (uint32_t key : pendingDisable) {
+        auto found = streams.find(key);
+        if (found != streams.end()) {
+            closeWindow(found->second, out);
+            streams.erase(found);
+        }
+    }
+    for (const auto& [key, config] : pendingEnable) {
+        streams[key].config = config;   // Re-enabling keeps the open window
+    }
+    pendingDisable.clear();
+    pendingEnable.clear();
+    hasPending.store(false, std::memory_order_relaxed);
+    active.store(!streams.empty(), std::memory_order_relaxed);
+}
+
+void LogAggregator::startWindow(Window& window, const LogMessage& msg) {
+    window.startNs = msg.getTimestampNs();
+    window.count = 0;
+    window.sum = 0.0;
+    window.last = msg;
+}
+
+void LogAggregator::closeWindow(Window& window, std::vector<LogMessage>& out) {
+    if (window.count == 0) {
+        return;
+    }
+    if (window.count == 1) {
+        out.push_back(window.last);
+    } else if (window.config.collapseRepeats && window.minValue == window.maxValue) {
+        out.push_back(LogMessage::repeat(window.last, window.count));
+        ++local.repeats;
+    } else {
+        float mean = static_cast<float>(window.sum / window.count);
+        out.push_back(LogMessage::summary(window.last, window.count, window.minValue, window.maxValue, mean));
+        ++local.summaries;
+    }
+    ++local.messagesOut;
+    window.count = 0;
+}
+
+void LogAggregator::process(const std::vector<LogMessage>& batch, std::vector<LogMessage>& out) {
+    applyPending(out);
+
+    for (const auto& msg : batch) {
+        auto found = streams.find(keyOf(msg.getAppId(), msg.getContextId()));
+        if (found == streams.end()) {
+            out.push_back(msg);
+            continue;
+        }
+
+        Window& window = found->second;
+        ++local.messagesIn;
+
+        // Alerts must not wait for the window: close it and forward the change
+        if (!window.seen || msg.getSeverity() != window.severity) {
+            closeWindow(window, out);
+            out.push_back(msg);
+            ++local.messagesOut;
+            if (window.seen) {
+                ++local.transitions;
+            }
+            window.seen = true;
+            window.severity = msg.getSeverity();
+            continue;
+        }
+
+        int64_t windowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(window.config.window).count();
+        if (window.count > 0 && msg.getTimestampNs() - window.startNs >= windowNs) {
+            closeWindow(window, out);
+        }
+        if (window.count == 0) {
+            startWindow(window, msg);
+            window.minValue = window.maxValue = msg.getValue();
+        }
+
+        float value = msg.getValue();
+        window.minValue = value < window.minValue ? value : window.minValue;
+        window.maxValue = value > window.maxValue ? value : window.maxValue;
+        window.sum += value;
+        window.last = msg;
+        if (++window.count == std::numeric_limits<uint32_t>::max()) {
+            closeWindow(window, out);
+        }
+    }
+    publishStats();
+}
+
+void LogAggregator::flushExpired(int64_t nowNs, std::vector<LogMessage>& out) {
+    applyPending(out);
+
+    for (auto& [key, window] : streams) {
+        int64_t windowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(window.config.window).count();
+        if (window.count > 0 && (nowNs == std::numeric_limits<int64_t>::max() || nowNs - window.startNs >= windowNs)) {
+            closeWindow(window, out);
+        }
+    }
+    publishStats();
+}
+
+void LogAggregator::publishStats() {
+    messagesIn.store(local.messagesIn, std::memory_order_relaxed);
+    messagesOut.store(local.messagesOut, std::memory_order_relaxed);
+    summaries.store(local.summaries, std::memory_order_relaxed);
+    repeats.store(local.repeats, std::memory_order_relaxed);
+    transitions.store(local.transitions, std::memory_order_relaxed);
+}
+
+AggregationStats LogAggregator::getStats() const {
+    AggregationStats stats;
+    stats.messagesIn = messagesIn.load(std::memory_order_relaxed);
+    stats.messagesOut = messagesOut.load(std::memory_order_relaxed);
+    stats.summaries = summaries.load(std::memory_order_relaxed);
+    stats.repeats = repeats.load(std::memory_order_relaxed);
+    stats.transitions = transitions.load(std::memory_order_relaxed);
+    return stats;
+}
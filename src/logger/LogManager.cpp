@@ -1,50 +1,496 @@
 #include "logger/LogManager.hpp"
 #include "sink/ILogSink.hpp"
+#include "logger/StringRegistry.hpp"
+#include <algorithm>
+#include <iostream>
+#include <limits>
 
 
-LogManager::LogManager(size_t capacity) 
-    : queue(capacity), stopFlag(false) {
+namespace {
+    LogManagerConfig makeConfig(size_t capacity, size_t maxBatch) {
+        LogManagerConfig config;
+        config.capacity = capacity;
+        config.maxBatch = maxBatch;
+        return config;
+    }
+
+    // Bounded attempts for DROP_OLDEST when other producers race for the freed slot
+    constexpr int MAX_EVICT_ATTEMPTS = 8;
+
+    // How often an idle consumer closes expired aggregation windows
+    constexpr std::chrono::milliseconds AGGREGATION_TICK{100};
+
+    // How often an idle consumer checks whether ASYNC sinks finished the
+    // batches that still hold shared queue slots
+    constexpr std::chrono::milliseconds RELEASE_TICK{1};
+
+    std::unique_ptr<SharedQueueFile> openSharedQueue(const LogManagerConfig& config, bool ownConsumer) {
+        if (!ownConsumer || config.sharedQueuePath.empty()) {
+            return nullptr;
+        }
+        return std::make_unique<SharedQueueFile>(config.sharedQueuePath, config.capacity);
+    }
+}
+
+LogManager::LogManager(size_t capacity, size_t maxBatch) 
+    : LogManager(makeConfig(capacity, maxBatch)) {}
+
+LogManager::LogManager(const LogManagerConfig& config)
+    : LogManager(config, true) {}
+
+LogManager::LogManager(const LogManagerConfig& config, bool ownConsumer)
+    : sharedQueue(openSharedQueue(config, ownConsumer)),
+      queue(ownConsumer ? config.capacity : 1, sharedQueue ? sharedQueue->slotStorage() : nullptr),
+      batchPool(config.maxBatch > 0 ? config.maxBatch : 1),
+      defaultDispatch(config.sinkDispatch),
+      defaultSinkQueue(config.sinkQueue),
+      maxBatch(config.maxBatch > 0 ? config.maxBatch : 1), 
+      minSeverity(config.minSeverity),
+      overflow(config.overflow),
+      metricsConfig(config.metrics),
+      startedAt(std::chrono::steady_clock::now()),
+      wakeup(config.wakeup),
+      stopFlag(false) {
+    batch.reserve(maxBatch);
+    sinkBatch.reserve(maxBatch);
+    if (sharedQueue) {
+        heldTickets.reserve(maxBatch);
+    }
+    if (metricsConfig.enqueueSampleEvery == 0) {
+        metricsConfig.enqueueSampleEvery = 1;
+    }
     // Start the worker thread immediately upon construction
-    workerThread = std::thread(&LogManager::processLoop, this);
+    if (ownConsumer) {
+        workerThread = std::thread(&LogManager::processLoop, this);
+    }
+    if (metricsConfig.enabled && metricsConfig.reportInterval.count() > 0) {
+        reportThread = std::thread(&LogManager::reportLoop, this);
+    }
 }
 
 
 void LogManager::addLog(LogMessage&& msg) {
+    // Formatters bound to minSeverity reject earlier; this catches the rest
+    if (!minSeverity.allows(msg.getSeverity())) {
+        counters.filtered.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Per-thread tick, so only one call in enqueueSampleEvery reads the clock
+    thread_local uint32_t sampleTick = 0;
+    if (!metricsConfig.enabled || ++sampleTick % metricsConfig.enqueueSampleEvery != 0) {
+        enqueue(std::move(msg));
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    enqueue(std::move(msg));
+    enqueueLatency.record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+}
+
+void LogManager::enqueue(LogMessage&& msg) {
+    // Names must reach the shared file before a record that uses them
+    if (sharedQueue && sharedQueue->namesStale()) {
+        sharedQueue->syncNames();
+    }
+
     // Try to push to the RingBuffer
-    if (queue.tryPush(std::move(msg))) {
-        // Only notify the thread if we successfully added a message
-        cv.notify_one(); 
+    QueuedMessage record(msg);
+    if (queue.tryPush(std::move(record))) {
+        wakeConsumer();
+        return;
+    }
+    handleOverflow(std::move(record));
+}
+
+void LogManager::handleOverflow(QueuedMessage&& msg) {
+    switch (overflow.policy) {
+        case OverflowPolicy_enum::BLOCK_WITH_TIMEOUT:
+            blockForSpace(msg, false);
+            break;
+
+        case OverflowPolicy_enum::SPIN_THEN_BLOCK:
+            blockForSpace(msg, true);
+            break;
+
+        case OverflowPolicy_enum::DROP_OLDEST:
+            for (int attempt = 0; attempt < MAX_EVICT_ATTEMPTS; ++attempt) {
+                if (queue.tryPop()) {
+                    counters.droppedOldest.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (queue.tryPush(std::move(msg))) {
+                    wakeConsumer();
+                    return;
+                }
+            }
+            counters.droppedNewest.fetch_add(1, std::memory_order_relaxed);
+            break;
+
+        case OverflowPolicy_enum::DROP_BELOW_SEVERITY:
+            if (msg.getSeverity() < overflow.keepAtOrAbove) {
+                counters.shedBySeverity.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                blockForSpace(msg, false);
+            }
+            break;
+
+        case OverflowPolicy_enum::DROP_NEWEST:
+        default:
+            counters.droppedNewest.fetch_add(1, std::memory_order_relaxed);
+            break;
+    }
+}
+
+bool LogManager::blockForSpace(QueuedMessage& msg, bool spinFirst) {
+    if (spinFirst) {
+        for (size_t i = 0; i < overflow.spinIterations; ++i) {
+            if (queue.tryPush(std::move(msg))) {
+                wakeConsumer();
+                return true;
+            }
+            std::this_thread::yield();
+        }
     }
+
+    // tryPush only moves from msg once a slot is claimed, so retrying is safe
+    blockedProducers.fetch_add(1);
+    bool pushed = false;
+    {
+        std::unique_lock<std::mutex> lock(spaceMtx);
+        spaceCv.wait_for(lock, overflow.blockTimeout, [this, &msg, &pushed] {
+            pushed = queue.tryPush(std::move(msg));
+            return pushed || stopFlag.load();
+        });
+    }
+    blockedProducers.fetch_sub(1);
+
+    if (pushed) {
+        counters.blockedPushes.fetch_add(1, std::memory_order_relaxed);
+        wakeConsumer();
+    } else {
+        counters.blockTimeouts.fetch_add(1, std::memory_order_relaxed);
+    }
+    return pushed;
 }
 
 void LogManager::addSink(std::unique_ptr<ILogSink> sink) {
-    sinks.push_back(std::move(sink));
+    addSink(std::move(sink), defaultDispatch, defaultSinkQueue);
+}
+
+void LogManager::addSink(std::unique_ptr<ILogSink> sink, SinkDispatch_enum dispatch) {
+    addSink(std::move(sink), dispatch, defaultSinkQueue);
+}
+
+void LogManager::addSink(std::unique_ptr<ILogSink> sink, SinkDispatch_enum dispatch,
+                         const SinkQueueConfig& queueConfig) {
+    if (!sink) {
+        return;
+    }
+    sink->setThresholdListener([this] { refreshSinkFloor(); });
+    if (dispatch == SinkDispatch_enum::ASYNC) {
+        asyncSinks.push_back(std::make_unique<AsyncSinkWorker>(std::move(sink), queueConfig, metricsConfig.enabled));
+        // Queued batches plus the one being written
+        batchPool.growLimit(queueConfig.depth + 1);
+    } else {
+        sinks.push_back(std::move(sink));
+        sinkTimings.push_back(std::make_unique<SinkTimings>());
+    }
+    refreshSinkFloor();
+}
+
+void LogManager::refreshSinkFloor() {
+    std::lock_guard<std::mutex> lock(floorMtx);
+    LogType floor = LogType::ERROR;
+    bool anySink = false;
+    for (const auto& sink : sinks) {
+        if (sink) {
+            floor = std::min(floor, sink->getMinSeverity());
+            anySink = true;
+        }
+    }
+    for (const auto& worker : asyncSinks) {
+        floor = std::min(floor, worker->getSink().getMinSeverity());
+        anySink = true;
+    }
+    if (!anySink || aggregator.isActive()) {
+        floor = LogType::INFO;
+    }
+    minSeverity.setFloor(floor);
+}
+
+void LogManager::setMinSeverity(LogType level) {
+    minSeverity.setMinSeverity(level);
+}
+
+LogType LogManager::getMinSeverity() const {
+    return minSeverity.getMinSeverity();
+}
+
+const SeverityFilter& LogManager::getSeverityFilter() const {
+    return minSeverity;
+}
+
+void LogManager::enableAggregation(const std::string& app, const std::string& context,
+                                   const AggregationConfig& config) {
+    aggregator.enable(StringRegistry::intern(app), StringRegistry::intern(context), config);
+    refreshSinkFloor();
+    forceWake();    // Switches the consumer to timed waits
+}
+
+void LogManager::disableAggregation(const std::string& app, const std::string& context) {
+    aggregator.disable(StringRegistry::intern(app), StringRegistry::intern(context));
+    refreshSinkFloor();
+    forceWake();
+}
+
+AggregationStats LogManager::getAggregationStats() const {
+    return aggregator.getStats();
+}
+
+std::vector<SinkLagStats> LogManager::getSinkLagStats() const {
+    std::vector<SinkLagStats> stats;
+    stats.reserve(asyncSinks.size());
+    for (const auto& worker : asyncSinks) {
+        stats.push_back(worker->getStats());
+    }
+    return stats;
+}
+
+OverflowStats LogManager::getOverflowStats() const {
+    OverflowStats stats;
+    stats.droppedNewest = counters.droppedNewest.load(std::memory_order_relaxed);
+    stats.droppedOldest = counters.droppedOldest.load(std::memory_order_relaxed);
+    stats.shedBySeverity = counters.shedBySeverity.load(std::memory_order_relaxed);
+    stats.blockTimeouts = counters.blockTimeouts.load(std::memory_order_relaxed);
+    stats.blockedPushes = counters.blockedPushes.load(std::memory_order_relaxed);
+    stats.filtered = counters.filtered.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void LogManager::wakeConsumer() {
+    wakeup.notify();
+}
+
+void LogManager::forceWake() {
+    wakeup.wakeAlways();
+}
+
+std::chrono::steady_clock::duration LogManager::parkLimit() const {
+    if (!heldBatches.empty()) {
+        return RELEASE_TICK;
+    }
+    if (aggregator.isActive()) {
+        return AGGREGATION_TICK;
+    }
+    return std::chrono::steady_clock::duration::max();
+}
+
+void LogManager::waitForMessages() {
+    wakeup.wait([this] { return !queue.isEmpty() || stopFlag.load(std::memory_order_relaxed); }, parkLimit());
+}
+
+void LogManager::deliver(const std::vector<LogMessage>& messages, HeldBatch* held) {
+    // One shared copy for all ASYNC sinks, recycled once the last one is done
+    if (!asyncSinks.empty()) {
+        SharedBatch local;
+        SharedBatch& shared = held ? held->batch : local;
+        shared = batchPool.acquire(messages);
+        if (held) {
+            held->idleRefs = shared.use_count();
+        }
+        for (auto& worker : asyncSinks) {
+            worker->enqueue(shared);
+        }
+    }
+
+    for (size_t i = 0; i < sinks.size(); ++i) {
+        if (!sinks[i]) {
+            continue;
+        }
+        if (!metricsConfig.enabled) {
+            sinks[i]->deliverBatch(messages, sinkBatch);
+            continue;
+        }
+        auto start = std::chrono::steady_clock::now();
+        const auto& written = sinks[i]->deliverBatch(messages, sinkBatch);
+        sinkTimings[i]->recordBatch(written, start);
+    }
 }
 
 void LogManager::processLoop() {
     while (true) {
-        std::unique_lock<std::mutex> lock(cvMtx);
-        
-        // Block here until data is available OR we are shutting down
-        cv.wait(lock, [this] { 
-            return stopFlag.load() || !queue.isEmpty(); 
-        });
+        waitForMessages();
+        if (!heldBatches.empty()) {
+            releaseDelivered();
+        }
 
         // Shutdown condition: flag is set AND no more logs are left to process
         if (stopFlag.load() && queue.isEmpty()) {
+            flushAggregation(std::numeric_limits<int64_t>::max());
             break; 
         }
 
-        lock.unlock(); // Release lock while writing to sinks (expensive I/O)
+        wakeups.fetch_add(1, std::memory_order_relaxed);
+
+        // Trade a little latency for fuller batches when configured
+        const auto& linger = wakeup.getConfig().batchLinger;
+        if (linger.count() > 0 && queue.sizeApprox() < maxBatch && !stopFlag.load()) {
+            std::this_thread::sleep_for(linger);
+        }
+
+        // Consume all available messages in the buffer, up to maxBatch at a time
+        while (!queue.isEmpty()) {
+            size_t depth = queue.sizeApprox();
+            if (depth > queueHighWater.load(std::memory_order_relaxed)) {
+                queueHighWater.store(depth, std::memory_order_relaxed);
+            }
+
+            batch.clear();
+            while (batch.size() < maxBatch) {
+                std::optional<QueuedMessage> msg;
+                if (sharedQueue) {
+                    size_t ticket;
+                    msg = queue.tryPopHeld(ticket);
+                    if (msg) {
+                        heldTickets.push_back(ticket);
+                    }
+                } else {
+                    msg = queue.tryPop();
+                }
+                if (!msg) {
+                    break;
+                }
+                batch.push_back(msg->toMessage());
+            }
+            if (batch.empty()) {
+                break; // A DROP_OLDEST producer evicted what we saw
+            }
+
+            // Heap slots are free already, shared ones once the sinks have the batch
+            if (!sharedQueue) {
+                wakeBlockedProducers();
+            }
+
+            HeldBatch held;
+            deliverDrained(batch, sharedQueue ? &held : nullptr);
 
-        // Consume all available messages in the buffer
-        while (auto msg = queue.tryPop()) {
-            for (auto& sink : sinks) {
-                if (sink) {
-                    sink->write(*msg);
+            if (sharedQueue) {
+                held.tickets = heldTickets.size();
+                for (const auto& earlier : heldBatches) {
+                    held.tickets -= earlier.tickets;
                 }
+                heldBatches.push_back(std::move(held));
+                releaseDelivered();
             }
         }
+
+        flushAggregation(ConsumerWakeup::nowNs());
+    }
+}
+
+void LogManager::deliverDrained(const std::vector<LogMessage>& messages, HeldBatch* held) {
+    batchesDrained.fetch_add(1, std::memory_order_relaxed);
+    messagesDrained.fetch_add(messages.size(), std::memory_order_relaxed);
+    if (!aggregator.isActive()) {
+        deliver(messages, held);
+        return;
+    }
+    aggregated.clear();
+    aggregator.process(messages, aggregated);
+    if (!aggregated.empty()) {
+        deliver(aggregated, held);
+    }
+}
+
+void LogManager::flushAggregation(int64_t nowNs) {
+    if (!aggregator.isActive()) {
+        return;
+    }
+    aggregated.clear();
+    aggregator.flushExpired(nowNs, aggregated);
+    if (!aggregated.empty()) {
+        deliver(aggregated);
+    }
+}
+
+void LogManager::releaseDelivered() {
+    // In order, so heldTickets stays a prefix per batch
+    size_t batches = 0;
+    size_t tickets = 0;
+    for (const auto& held : heldBatches) {
+        if (held.batch && held.batch.use_count() > held.idleRefs) {
+            break;
+        }
+        ++batches;
+        tickets += held.tickets;
+    }
+    if (batches == 0) {
+        return;
+    }
+    for (size_t i = 0; i < tickets; ++i) {
+        queue.release(heldTickets[i]);
+    }
+    heldTickets.erase(heldTickets.begin(), heldTickets.begin() + static_cast<std::ptrdiff_t>(tickets));
+    heldBatches.erase(heldBatches.begin(), heldBatches.begin() + static_cast<std::ptrdiff_t>(batches));
+    wakeBlockedProducers();
+}
+
+void LogManager::wakeBlockedProducers() {
+    // Space was freed, wake producers blocked by the overflow policy
+    if (blockedProducers.load() > 0) {
+        std::lock_guard<std::mutex> spaceLock(spaceMtx);
+        spaceCv.notify_all();
+    }
+}
+
+size_t LogManager::getQueueDepth() const {
+    return queue.sizeApprox();
+}
+
+LogManagerMetrics LogManager::getMetrics() const {
+    LogManagerMetrics metrics;
+    metrics.uptimeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startedAt).count();
+    metrics.queueCapacity = queue.capacity();
+    metrics.queueDepth = queue.sizeApprox();
+    metrics.queueHighWater = queueHighWater.load(std::memory_order_relaxed);
+    metrics.wakeups = wakeups.load(std::memory_order_relaxed);
+    metrics.parks = wakeup.parkCount();
+    metrics.spinWakeups = wakeup.spinWakeupCount();
+    metrics.notifies = wakeup.notifyCount();
+    metrics.batches = batchesDrained.load(std::memory_order_relaxed);
+    metrics.messages = messagesDrained.load(std::memory_order_relaxed);
+    metrics.enqueueLatency = enqueueLatency.snapshot();
+    metrics.overflow = getOverflowStats();
+    metrics.batchPoolSlots = batchPool.slotCount();
+    metrics.batchPoolReused = batchPool.reusedCount();
+    metrics.batchPoolAllocations = batchPool.allocationCount();
+
+    auto describeSink = [](SinkDispatch_enum dispatch, const SinkTimings& timings) {
+        SinkMetrics sink;
+        sink.dispatch = dispatch;
+        sink.batches = timings.batches.load(std::memory_order_relaxed);
+        sink.writeTime = timings.writeTime.snapshot();
+        sink.endToEnd = timings.endToEnd.snapshot();
+        return sink;
+    };
+    for (const auto& timings : sinkTimings) {
+        metrics.sinks.push_back(describeSink(SinkDispatch_enum::INLINE, *timings));
+    }
+    for (const auto& worker : asyncSinks) {
+        metrics.sinks.push_back(describeSink(SinkDispatch_enum::ASYNC, worker->getTimings()));
+    }
+    return metrics;
+}
+
+void LogManager::reportLoop() {
+    std::ostream& out = metricsConfig.reportStream ? *metricsConfig.reportStream : std::clog;
+    LogManagerMetrics previous = getMetrics();
+
+    std::unique_lock<std::mutex> lock(reportMtx);
+    while (!reportCv.wait_for(lock, metricsConfig.reportInterval, [this] { return stopFlag.load(); })) {
+        LogManagerMetrics current = getMetrics();
+        out << describeMetrics(current, &previous) << '\n' << std::flush;
+        previous = std::move(current);
     }
 }
 
@@ -53,10 +499,29 @@ LogManager::~LogManager() {
     stopFlag = true;
     
     // 2. Wake it up one last time in case it is sleeping on cv.wait()
-    cv.notify_all();
+    forceWake();
+    {
+        std::lock_guard<std::mutex> spaceLock(spaceMtx);
+        spaceCv.notify_all();
+    }
+    
+    {
+        std::lock_guard<std::mutex> reportLock(reportMtx);
+        reportCv.notify_all();
+    }
+    if (reportThread.joinable()) {
+        reportThread.join();
+    }
     
     // 3. Wait for it to finish flushing the remaining logs
     if (workerThread.joinable()) {
         workerThread.join();
     }
+
+    // Everything reached the sinks, nothing to recover; ASYNC workers
+    // drain their queues before they stop
+    asyncSinks.clear();
+    if (sharedQueue) {
+        sharedQueue->markClean();
+    }
 }
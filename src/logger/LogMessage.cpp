@@ -1,35 +1,50 @@
 #include "logger/LogMessage.hpp"
-#include <iomanip>
-#include <ctime>
+#include "logger/LogRenderer.hpp"
 
-LogMessage::LogMessage(const std::string& app_name,
-                       const std::string& context,
+LogMessage::LogMessage(uint16_t appId,
+                       uint16_t contextId,
+                       uint8_t policyId,
                        LogType severity,
-                       std::chrono::system_clock::time_point timestamp,
-                       const std::string& message)
-    : app_name{app_name}, context{context}, timestamp{timestamp}, 
-      severity{severity}, message{message} {}
+                       float value,
+                       std::chrono::system_clock::time_point timestamp)
+    : timestampNs{std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count()},
+      value{value}, appId{appId}, contextId{contextId}, policyId{policyId}, severity{severity} {}
 
+LogMessage LogMessage::summary(const LogMessage& last, uint32_t count, float minValue, float maxValue, float meanValue) {
+    LogMessage msg = last;
+    msg.kind = LogKind::SUMMARY;
+    msg.count = count;
+    msg.minValue = minValue;
+    msg.maxValue = maxValue;
+    msg.meanValue = meanValue;
+    return msg;
+}
 
-      
-std::string LogTypeToString(LogType type) {
-    switch (type) {
-        case LogType::INFO:    return "INFO";
-        case LogType::WARNING: return "WARNING";
-        case LogType::ERROR:   return "ERROR";
-        default:               return "UNKNOWN";
-    }
+LogMessage LogMessage::repeat(const LogMessage& sample, uint32_t count) {
+    LogMessage msg = sample;
+    msg.kind = LogKind::REPEAT;
+    msg.count = count;
+    msg.minValue = msg.maxValue = msg.meanValue = sample.value;
+    return msg;
 }
 
-std::ostream& operator<<(std::ostream& os, const LogMessage& msg) {
+std::chrono::system_clock::time_point LogMessage::getTimestamp() const {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(timestampNs)));
+}
 
-    std::time_t t = std::chrono::system_clock::to_time_t(msg.timestamp);
-    std::tm tm = *std::localtime(&t);
+std::string LogMessage::describe() const {
+    std::string text(LogRenderer::maxDescriptionLength(*this), '\0');
+    text.resize(LogRenderer::renderDescription(*this, text.data(), text.size()));
+    return text;
+}
 
-    os << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << " "
-       << "[" << std::left << std::setw(7) << LogTypeToString(msg.severity) << "] "
-       << "[" << msg.app_name << "::" << msg.context << "] "
-       << msg.message;
-       
+// Thin wrapper kept for existing stream users; sinks call LogRenderer directly
+std::ostream& operator<<(std::ostream& os, const LogMessage& msg) {
+    thread_local LogRenderer renderer;
+    thread_local std::string line;
+    line.clear();
+    renderer.append(msg, line);
+    os.write(line.data(), static_cast<std::streamsize>(line.size() - 1));    // Without the newline
     return os;
-}
\ No newline at end of file
+}
@@ -0,0 +1,122 @@
+#include "logger/LogMetrics.hpp"
+#include <cmath>
+#include <sstream>
+
+namespace {
+    // 1234 -> "1.2us", keeps the self-report line short
+    std::string formatNs(uint64_t ns) {
+        std::ostringstream out;
+        out.precision(1);
+        out << std::fixed;
+        if (ns < 1'000) {
+            out.precision(0);
+            out << ns << "ns";
+        } else if (ns < 1'000'000) {
+            out << ns / 1e3 << "us";
+        } else if (ns < 1'000'000'000) {
+            out << ns / 1e6 << "ms";
+        } else {
+            out << ns / 1e9 << "s";
+        }
+        return out.str();
+    }
+}
+
+LatencyHistogram::LatencyHistogram() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t LatencyHistogram::upperBoundOf(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    int msb = static_cast<int>(index / SUB_BUCKETS) + SUB_BITS - 1;
+    int shift = msb - SUB_BITS;
+    uint64_t lower = (SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return lower + ((uint64_t{1} << shift) - 1);
+}
+
+HistogramSnapshot LatencyHistogram::snapshot() const {
+    HistogramSnapshot snap;
+    uint64_t counts[BUCKETS];
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    snap.count = total;
+    snap.sumNs = sum.load(std::memory_order_relaxed);
+    snap.maxNs = max.load(std::memory_order_relaxed);
+    if (total == 0) {
+        return snap;
+    }
+
+    const double quantiles[] = {0.50, 0.90, 0.99, 0.999};
+    uint64_t* targets[] = {&snap.p50Ns, &snap.p90Ns, &snap.p99Ns, &snap.p999Ns};
+    size_t next = 0;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS && next < 4; ++i) {
+        seen += counts[i];
+        while (next < 4 && seen > 0 &&
+               seen >= static_cast<uint64_t>(std::ceil(quantiles[next] * static_cast<double>(total)))) {
+            uint64_t bound = upperBoundOf(i);
+            *targets[next++] = bound < snap.maxNs ? bound : snap.maxNs;
+        }
+    }
+    return snap;
+}
+
+void SinkTimings::recordBatch(const std::vector<LogMessage>& messages, std::chrono::steady_clock::time_point start) {
+    if (messages.empty()) {
+        return;
+    }
+    auto done = std::chrono::steady_clock::now();
+    writeTime.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(done - start).count()));
+    batches.fetch_add(1, std::memory_order_relaxed);
+
+    int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    endToEnd.recordMany(messages.size(), [&](size_t i) {
+        int64_t age = nowNs - messages[i].getTimestampNs();
+        return age > 0 ? static_cast<uint64_t>(age) : uint64_t{0};
+    });
+}
+
+std::string describeMetrics(const LogManagerMetrics& current, const LogManagerMetrics* previous) {
+    double seconds = current.uptimeSeconds;
+    uint64_t wakeups = current.wakeups;
+    uint64_t messages = current.messages;
+    uint64_t notifies = current.notifies;
+    uint64_t dropped = current.overflow.totalDropped();
+    if (previous != nullptr) {
+        seconds -= previous->uptimeSeconds;
+        wakeups -= previous->wakeups;
+        notifies -= previous->notifies;
+        messages -= previous->messages;
+        dropped -= previous->overflow.totalDropped();
+    }
+    if (seconds <= 0) {
+        seconds = 1e-9;
+    }
+
+    std::ostringstream out;
+    out.precision(0);
+    out << std::fixed;
+    out << "telelog: queue " << current.queueDepth << '/' << current.queueCapacity
+        << " hwm " << current.queueHighWater
+        << " | " << messages / seconds << " msg/s, " << wakeups / seconds << " wakeups/s, "
+        << notifies / seconds << " notifies/s, "
+        << dropped << " dropped"
+        << " | enqueue p50 " << formatNs(current.enqueueLatency.p50Ns)
+        << " p99 " << formatNs(current.enqueueLatency.p99Ns);
+    for (size_t i = 0; i < current.sinks.size(); ++i) {
+        const SinkMetrics& sink = current.sinks[i];
+        out << " | sink" << i << (sink.dispatch == SinkDispatch_enum::ASYNC ? " async" : "")
+            << " write p99 " << formatNs(sink.writeTime.p99Ns)
+            << " e2e p50 " << formatNs(sink.endToEnd.p50Ns)
+            << " p99 " << formatNs(sink.endToEnd.p99Ns);
+    }
+    return out.str();
+}
@@ -0,0 +1,215 @@
+#include "logger/LogRenderer.hpp"
+#include "logger/StringRegistry.hpp"
+#include "logger/PolicyRegistry.hpp"
+#include <charconv>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <string_view>
+
+namespace {
+    // Bounded output cursor, silently truncates once the buffer is full
+    struct Cursor {
+        char* pos;
+        char* end;
+
+        void put(std::string_view text) {
+            size_t n = std::min(text.size(), static_cast<size_t>(end - pos));
+            std::memcpy(pos, text.data(), n);
+            pos += n;
+        }
+
+        void put(char ch) {
+            if (pos < end) {
+                *pos++ = ch;
+            }
+        }
+
+        void putFixed(float value, int precision) {
+            auto result = std::to_chars(pos, end, value, std::chars_format::fixed, precision);
+            if (result.ec == std::errc()) {
+                pos = result.ptr;
+            }
+        }
+    };
+
+    // Date/time with nanoseconds and 'Z', a space, the severity tag and the
+    // "[", "::", "] " around the names
+    constexpr size_t MAX_PREFIX = 19 + 10 + 1 + 1 + 10 + 5;
+
+    // Indexed by LogType, padded like the former std::setw(7)
+    constexpr std::string_view SEVERITY_TAGS[] = {
+        "[INFO   ] ",
+        "[WARNING] ",
+        "[ERROR  ] ",
+    };
+
+    constexpr std::string_view UNKNOWN_TAG = "[UNKNOWN] ";
+
+    void writeDigits(char* out, unsigned value, int width) {
+        for (int i = width - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+
+    void putCount(Cursor& cursor, uint32_t count) {
+        auto result = std::to_chars(cursor.pos, cursor.end, count);
+        if (result.ec == std::errc()) {
+            cursor.pos = result.ptr;
+        }
+    }
+
+    void writeDescription(Cursor& cursor, const LogMessage& msg) {
+        const PolicyInfo& policy = PolicyRegistry::lookup(msg.getPolicyId());
+        const MessageTemplate& message = policy.message;
+        std::string_view unit = policy.unit;
+        int precision = message.precision;
+
+        for (size_t i = 0; i < message.count; ++i) {
+            const MessageTemplate::Piece& piece = message.pieces[i];
+            switch (piece.field) {
+                case MessageTemplate::Field::LITERAL:
+                    cursor.put(piece.literal);
+                    break;
+                case MessageTemplate::Field::CONTEXT:
+                    cursor.put(StringRegistry::lookup(msg.getContextId()));
+                    break;
+                case MessageTemplate::Field::VALUE:
+                    cursor.putFixed(msg.getValue(), precision);
+                    break;
+                case MessageTemplate::Field::UNIT:
+                    cursor.put(unit);
+                    break;
+            }
+        }
+
+        switch (msg.getKind()) {
+            case LogKind::SUMMARY:
+                cursor.put(" [n=");
+                putCount(cursor, msg.getCount());
+                cursor.put(" min ");
+                cursor.putFixed(msg.getMinValue(), precision);
+                cursor.put(unit);
+                cursor.put(" max ");
+                cursor.putFixed(msg.getMaxValue(), precision);
+                cursor.put(unit);
+                cursor.put(" mean ");
+                cursor.putFixed(msg.getMeanValue(), precision);
+                cursor.put(unit);
+                cursor.put(']');
+                break;
+            case LogKind::REPEAT:
+                cursor.put(" (repeated ");
+                putCount(cursor, msg.getCount());
+                cursor.put(" times)");
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+LogRenderer::LogRenderer(RenderOptions options)
+    : options(options), cachedSecond(std::numeric_limits<int64_t>::min()), cachedPrefix{} {}
+
+void LogRenderer::refreshPrefix(int64_t second) {
+    std::time_t t = static_cast<std::time_t>(second);
+    std::tm tm{};
+    if (options.utc) {
+        gmtime_r(&t, &tm);
+    } else {
+        localtime_r(&t, &tm);
+    }
+
+    writeDigits(cachedPrefix, static_cast<unsigned>(tm.tm_year + 1900), 4);
+    cachedPrefix[4] = '-';
+    writeDigits(cachedPrefix + 5, static_cast<unsigned>(tm.tm_mon + 1), 2);
+    cachedPrefix[7] = '-';
+    writeDigits(cachedPrefix + 8, static_cast<unsigned>(tm.tm_mday), 2);
+    cachedPrefix[10] = ' ';
+    writeDigits(cachedPrefix + 11, static_cast<unsigned>(tm.tm_hour), 2);
+    cachedPrefix[13] = ':';
+    writeDigits(cachedPrefix + 14, static_cast<unsigned>(tm.tm_min), 2);
+    cachedPrefix[16] = ':';
+    writeDigits(cachedPrefix + 17, static_cast<unsigned>(tm.tm_sec), 2);
+    cachedSecond = second;
+}
+
+size_t LogRenderer::render(const LogMessage& msg, char* out, size_t capacity) {
+    constexpr int64_t NS_PER_SEC = 1'000'000'000;
+    int64_t ns = msg.getTimestampNs();
+    int64_t second = ns / NS_PER_SEC;
+    int64_t fraction = ns % NS_PER_SEC;
+    if (fraction < 0) {
+        --second;
+        fraction += NS_PER_SEC;
+    }
+    if (second != cachedSecond) {
+        refreshPrefix(second);
+    }
+
+    Cursor cursor{out, out + capacity};
+    cursor.put(std::string_view(cachedPrefix, sizeof(cachedPrefix)));
+
+    if (options.subSecondDigits > 0) {
+        int digits = options.subSecondDigits > 9 ? 9 : options.subSecondDigits;
+        unsigned scaled = static_cast<unsigned>(fraction);
+        for (int i = digits; i < 9; ++i) {
+            scaled /= 10;
+        }
+        char fractionText[10];
+        fractionText[0] = '.';
+        writeDigits(fractionText + 1, scaled, digits);
+        cursor.put(std::string_view(fractionText, static_cast<size_t>(digits) + 1));
+    }
+    if (options.utc) {
+        cursor.put('Z');
+    }
+    cursor.put(' ');
+
+    size_t level = static_cast<size_t>(msg.getSeverity());
+    cursor.put(level < std::size(SEVERITY_TAGS) ? SEVERITY_TAGS[level] : UNKNOWN_TAG);
+
+    cursor.put('[');
+    cursor.put(StringRegistry::lookup(msg.getAppId()));
+    cursor.put("::");
+    cursor.put(StringRegistry::lookup(msg.getContextId()));
+    cursor.put("] ");
+
+    writeDescription(cursor, msg);
+    return static_cast<size_t>(cursor.pos - out);
+}
+
+size_t LogRenderer::maxDescriptionLength(const LogMessage& msg) {
+    const PolicyInfo& policy = PolicyRegistry::lookup(msg.getPolicyId());
+    return policy.message.maxRenderedLength(policy.unit.size()) +
+           policy.message.contextSlots() * StringRegistry::lookup(msg.getContextId()).size();
+}
+
+size_t LogRenderer::maxLineLength(const LogMessage& msg) {
+    return MAX_PREFIX + StringRegistry::lookup(msg.getAppId()).size() +
+           StringRegistry::lookup(msg.getContextId()).size() + maxDescriptionLength(msg);
+}
+
+void LogRenderer::append(const LogMessage& msg, std::string& buffer) {
+    size_t bound = maxLineLength(msg);
+    if (bound <= MAX_LINE) {
+        char line[MAX_LINE + 1];
+        size_t written = render(msg, line, MAX_LINE);
+        line[written] = '\n';
+        buffer.append(line, written + 1);
+        return;
+    }
+    size_t start = buffer.size();
+    buffer.resize(start + bound + 1);
+    size_t written = render(msg, &buffer[start], bound);
+    buffer[start + written] = '\n';
+    buffer.resize(start + written + 1);
+}
+
+size_t LogRenderer::renderDescription(const LogMessage& msg, char* out, size_t capacity) {
+    Cursor cursor{out, out + capacity};
+    writeDescription(cursor, msg);
+    return static_cast<size_t>(cursor.pos - out);
+}
@@ -0,0 +1,69 @@
+#include "logger/PolicyRegistry.hpp"
+#include "logger/StringRegistry.hpp"
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace {
+    struct Storage {
+        std::mutex mtx;
+        std::array<PolicyInfo, PolicyRegistry::MAX_POLICIES> entries{};
+        std::atomic<size_t> count{1};   // Slot 0 is the generic policy
+    };
+
+    Storage& storage() {
+        static Storage instance;
+        return instance;
+    }
+}
+
+uint8_t PolicyRegistry::add(const PolicyInfo& info) {
+    Storage& s = storage();
+    std::lock_guard<std::mutex> lock(s.mtx);
+
+    size_t id = s.count.load(std::memory_order_relaxed);
+    if (id >= MAX_POLICIES) {
+        return GENERIC_ID;
+    }
+    s.entries[id] = info;
+    s.count.store(id + 1, std::memory_order_release);
+    return static_cast<uint8_t>(id);
+}
+
+const PolicyInfo& PolicyRegistry::lookup(uint8_t id) {
+    Storage& s = storage();
+    if (id >= s.count.load(std::memory_order_acquire)) {
+        return s.entries[GENERIC_ID];
+    }
+    return s.entries[id];
+}
+
+size_t PolicyRegistry::size() {
+    return storage().count.load(std::memory_order_acquire);
+}
+
+uint8_t PolicyRegistry::define(std::string_view unit, std::string_view messageTemplate, int precision) {
+    static std::mutex mtx;
+    static std::map<std::tuple<std::string, std::string, int>, uint8_t> defined;
+
+    MessageTemplate message = MessageTemplate::parse(messageTemplate, precision);
+    if (!message.valid) {
+        message = MessageTemplate::makeDefault();
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    auto key = std::make_tuple(std::string(unit), std::string(message.text), message.precision);
+    auto found = defined.find(key);
+    if (found != defined.end()) {
+        return found->second;
+    }
+    // The registry keeps views, so the texts must live in the string registry
+    std::string_view stableUnit = StringRegistry::lookup(StringRegistry::intern(unit));
+    std::string_view stableText = StringRegistry::lookup(StringRegistry::intern(message.text));
+    uint8_t id = add(PolicyInfo{stableUnit, MessageTemplate::parse(stableText, message.precision)});
+    defined.emplace(std::move(key), id);
+    return id;
+}
@@ -0,0 +1,349 @@
+#include "logger/ShardedLogManager.hpp"
+#include <sched.h>
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace {
+    // Longest nap while the oldest head waits for the reorder window, so an
+    // idle shard that wakes up is noticed soon
+    constexpr std::chrono::microseconds WINDOW_POLL{100};
+
+    constexpr std::greater<std::pair<int64_t, uint32_t>> LATER_FIRST{};    // Turns the std heap into a min-heap
+
+    bool earlierThan(const QueuedMessage& a, const QueuedMessage& b) {
+        return a.getTimestampNs() < b.getTimestampNs();
+    }
+
+    uint64_t nextInstanceId() {
+        static std::atomic<uint64_t> counter{1};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    size_t resolveShardCount(size_t requested) {
+        if (requested > 0) {
+            return requested;
+        }
+        unsigned hardware = std::thread::hardware_concurrency();
+        return hardware > 0 ? hardware : 1;
+    }
+}
+
+ShardedLogManager::ShardedLogManager(const ShardedLogManagerConfig& cfg)
+    : config(cfg),
+      instanceId(nextInstanceId()),
+      output(cfg.output, false),
+      lastMergedNs(std::numeric_limits<int64_t>::min()),
+      wakeup(cfg.wakeup) {
+    size_t count = resolveShardCount(config.shards);
+    if (config.mergeBatch == 0) {
+        config.mergeBatch = 1;
+    }
+    if (config.output.maxBatch == 0) {
+        config.output.maxBatch = 1;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        shards.push_back(std::make_unique<Shard>(config.shardCapacity));
+    }
+    staging.resize(count);
+    for (Staging& buffer : staging) {
+        buffer.messages.reserve(config.mergeBatch);
+    }
+    heads.reserve(count);
+    mergedBatch.reserve(config.output.maxBatch);
+    idleShards = count;
+
+    mergerThread = std::thread(&ShardedLogManager::mergeLoop, this);
+}
+
+ShardedLogManager::~ShardedLogManager() {
+    stopFlag.store(true);
+    wakeup.wakeAlways();
+    if (mergerThread.joinable()) {
+        mergerThread.join();
+    }
+}
+
+void ShardedLogManager::addLog(LogMessage&& msg) {
+    if (!output.getSeverityFilter().allows(msg.getSeverity())) {
+        output.counters.filtered.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Shard& shard = shardForThisThread();
+    QueuedMessage record(msg);
+    if (shard.queue.tryPush(std::move(record))) {
+        shard.pushed.fetch_add(1, std::memory_order_relaxed);
+        wakeup.notify();
+        return;
+    }
+    pushFull(shard, std::move(record));
+}
+
+ShardedLogManager::Shard& ShardedLogManager::shardForThisThread() {
+    if (config.affinity == ShardAffinity_enum::PER_CPU) {
+        int cpu = sched_getcpu();
+        return *shards[static_cast<size_t>(cpu > 0 ? cpu : 0) % shards.size()];
+    }
+
+    // One lease per thread; a thread alternating between two managers gives
+    // up its shard in the one it leaves, so it is counted only once
+    thread_local ProducerLease lease;
+    if (lease.owner != instanceId) {
+        lease.release();
+        // Fewest live producers, round-robin among equals, so threads that
+        // exited free their shard for the next one
+        size_t start = nextShard.fetch_add(1, std::memory_order_relaxed);
+        Shard* shard = nullptr;
+        uint32_t fewest = UINT32_MAX;
+        for (size_t i = 0; i < shards.size(); ++i) {
+            Shard* candidate = shards[(start + i) % shards.size()].get();
+            uint32_t count = candidate->producers->load(std::memory_order_relaxed);
+            if (count < fewest) {
+                fewest = count;
+                shard = candidate;
+            }
+        }
+        shard->producers->fetch_add(1, std::memory_order_relaxed);
+        lease.producers = shard->producers;
+        lease.shard = shard;
+        lease.owner = instanceId;
+    }
+    return *lease.shard;
+}
+
+void ShardedLogManager::pushFull(Shard& shard, QueuedMessage&& msg) {
+    if (config.overflow.policy != OverflowPolicy_enum::DROP_NEWEST) {
+        // tryPush only moves from msg once a slot is claimed, so retrying is safe
+        auto deadline = std::chrono::steady_clock::now() + config.overflow.blockTimeout;
+        do {
+            wakeup.notify();
+            std::this_thread::yield();
+            if (shard.queue.tryPush(std::move(msg))) {
+                shard.pushed.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        } while (std::chrono::steady_clock::now() < deadline && !stopFlag.load(std::memory_order_relaxed));
+    }
+    shard.dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool ShardedLogManager::isShared(uint32_t index) const {
+    return config.affinity == ShardAffinity_enum::PER_CPU ||
+        shards[index]->producers->load(std::memory_order_relaxed) > 1;
+}
+
+bool ShardedLogManager::anyShardPending() const {
+    for (const auto& shard : shards) {
+        if (!shard->queue.isEmpty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ShardedLogManager::refill(uint32_t index) {
+    Staging& buffer = staging[index];
+    bool wasEmpty = buffer.empty();
+    if (wasEmpty) {
+        buffer.messages.clear();
+        buffer.next = 0;
+    } else if (buffer.next > buffer.messages.size() / 2) {
+        buffer.messages.erase(buffer.messages.begin(), buffer.messages.begin() + static_cast<std::ptrdiff_t>(buffer.next));
+        buffer.next = 0;
+    }
+
+    // Keep shard queues drained while heads wait on the window, up to one
+    // queue's worth of staged messages
+    ShardQueue& queue = shards[index]->queue;
+    size_t room = config.shardCapacity > buffer.messages.size() - buffer.next
+        ? config.shardCapacity - (buffer.messages.size() - buffer.next) : 0;
+    size_t limit = std::min(room, config.mergeBatch);
+    size_t staged = buffer.messages.size();
+    for (size_t i = 0; i < limit; ++i) {
+        auto msg = queue.tryPop();
+        if (!msg) {
+            break;
+        }
+        buffer.messages.push_back(*msg);
+    }
+
+    // Producers interleave on a shared shard: insertion sort keeps the staged
+    // messages in timestamp order, cheaply since each producer's run is sorted
+    if (staged < buffer.messages.size() && isShared(index)) {
+        auto first = buffer.messages.begin() + static_cast<std::ptrdiff_t>(buffer.next);
+        int64_t front = wasEmpty ? 0 : first->getTimestampNs();
+        for (size_t i = staged; i < buffer.messages.size(); ++i) {
+            QueuedMessage msg = buffer.messages[i];
+            auto slot = buffer.messages.begin() + static_cast<std::ptrdiff_t>(i);
+            for (; slot != first && earlierThan(msg, *(slot - 1)); --slot) {
+                *slot = *(slot - 1);
+            }
+            *slot = msg;
+        }
+        if (!wasEmpty && first->getTimestampNs() != front) {
+            headsStale = true;
+        }
+    }
+
+    if (wasEmpty && !buffer.empty()) {
+        heads.emplace_back(buffer.messages[buffer.next].getTimestampNs(), index);
+        std::push_heap(heads.begin(), heads.end(), LATER_FIRST);
+        --idleShards;
+        return true;
+    }
+    return false;
+}
+
+void ShardedLogManager::rebuildHeads() {
+    heads.clear();
+    for (uint32_t i = 0; i < staging.size(); ++i) {
+        if (!staging[i].empty()) {
+            heads.emplace_back(staging[i].messages[staging[i].next].getTimestampNs(), i);
+        }
+    }
+    std::make_heap(heads.begin(), heads.end(), LATER_FIRST);
+    headsStale = false;
+}
+
+size_t ShardedLogManager::mergeReady(bool draining) {
+    if (headsStale) {
+        rebuildHeads();
+    }
+    const int64_t watermark = ConsumerWakeup::nowNs() -
+        std::chrono::duration_cast<std::chrono::nanoseconds>(config.reorderWindow).count();
+    // Heads beat everything still queued only if every shard is FIFO and has
+    // something staged; otherwise they wait out the window
+    bool anyShared = false;
+    for (uint32_t i = 0; i < shards.size() && !anyShared; ++i) {
+        anyShared = isShared(i);
+    }
+    const bool windowOnly = !draining && anyShared;
+    size_t emitted = 0;
+
+    while (!heads.empty()) {
+        auto [timestamp, index] = heads.front();
+        if ((windowOnly || (!draining && idleShards > 0)) && timestamp > watermark) {
+            break;
+        }
+        std::pop_heap(heads.begin(), heads.end(), LATER_FIRST);
+        heads.pop_back();
+
+        Staging& buffer = staging[index];
+        mergedBatch.push_back(buffer.messages[buffer.next++].toMessage());
+        if (timestamp < lastMergedNs) {
+            late.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            lastMergedNs = timestamp;
+        }
+        ++emitted;
+        if (mergedBatch.size() >= config.output.maxBatch) {
+            output.deliverDrained(mergedBatch);
+            mergedBatch.clear();
+        }
+
+        if (buffer.empty()) {
+            ++idleShards;
+            refill(index);
+        } else {
+            heads.emplace_back(buffer.messages[buffer.next].getTimestampNs(), index);
+            std::push_heap(heads.begin(), heads.end(), LATER_FIRST);
+        }
+    }
+    if (!mergedBatch.empty()) {
+        output.deliverDrained(mergedBatch);
+        mergedBatch.clear();
+    }
+    merged.fetch_add(emitted, std::memory_order_relaxed);
+    return emitted;
+}
+
+void ShardedLogManager::idle() {
+    // Heads are waiting for the window: nap, new shard data is picked up on return
+    if (!heads.empty()) {
+        windowWaits.fetch_add(1, std::memory_order_relaxed);
+        int64_t releaseIn = heads.front().first - ConsumerWakeup::nowNs() +
+            std::chrono::duration_cast<std::chrono::nanoseconds>(config.reorderWindow).count();
+        auto nap = std::min<std::chrono::nanoseconds>(std::chrono::nanoseconds(std::max<int64_t>(releaseIn, 0)), WINDOW_POLL);
+        std::this_thread::sleep_for(nap);
+        return;
+    }
+
+    wakeup.wait([this] { return stopFlag.load(std::memory_order_relaxed) || anyShardPending(); }, output.parkLimit());
+    wakeups.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ShardedLogManager::mergeLoop() {
+    while (true) {
+        bool stopping = stopFlag.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < staging.size(); ++i) {
+            refill(i);
+        }
+        size_t emitted = mergeReady(stopping);
+
+        if (stopping) {
+            // Producers are gone: flush everything in order, window or not
+            if (heads.empty() && !anyShardPending()) {
+                break;
+            }
+            continue;
+        }
+        if (emitted == 0) {
+            idle();
+        }
+        if (output.aggregator.isActive()) {
+            output.flushAggregation(ConsumerWakeup::nowNs());
+        }
+    }
+    output.flushAggregation(std::numeric_limits<int64_t>::max());
+}
+
+void ShardedLogManager::addSink(std::unique_ptr<ILogSink> sink) {
+    output.addSink(std::move(sink));
+}
+
+void ShardedLogManager::addSink(std::unique_ptr<ILogSink> sink, SinkDispatch_enum dispatch) {
+    output.addSink(std::move(sink), dispatch);
+}
+
+void ShardedLogManager::setMinSeverity(LogType level) {
+    output.setMinSeverity(level);
+}
+
+const SeverityFilter& ShardedLogManager::getSeverityFilter() const {
+    return output.getSeverityFilter();
+}
+
+size_t ShardedLogManager::shardCount() const {
+    return shards.size();
+}
+
+ShardedStats ShardedLogManager::getStats() const {
+    ShardedStats stats;
+    for (const auto& shard : shards) {
+        ShardStats entry;
+        entry.pushed = shard->pushed.load(std::memory_order_relaxed);
+        entry.dropped = shard->dropped.load(std::memory_order_relaxed);
+        entry.depth = shard->queue.sizeApprox();
+        entry.producers = shard->producers->load(std::memory_order_relaxed);
+        stats.shards.push_back(entry);
+    }
+    stats.merged = merged.load(std::memory_order_relaxed);
+    stats.late = late.load(std::memory_order_relaxed);
+    stats.windowWaits = windowWaits.load(std::memory_order_relaxed);
+    return stats;
+}
+
+LogManagerMetrics ShardedLogManager::getMetrics() const {
+    LogManagerMetrics metrics = output.getMetrics();
+    metrics.queueCapacity = 0;
+    metrics.queueDepth = 0;
+    for (const auto& shard : shards) {
+        metrics.queueCapacity += shard->queue.capacity();
+        metrics.queueDepth += shard->queue.sizeApprox();
+    }
+    metrics.wakeups = wakeups.load(std::memory_order_relaxed);
+    metrics.parks = wakeup.parkCount();
+    metrics.spinWakeups = wakeup.spinWakeupCount();
+    metrics.notifies = wakeup.notifyCount();
+    return metrics;
+}
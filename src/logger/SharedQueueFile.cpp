@@ -0,0 +1,295 @@
+#include "logger/SharedQueueFile.hpp"
+#include "logger/LockFreeRingBuffer.hpp"
+#include "logger/StringRegistry.hpp"
+#include "logger/PolicyRegistry.hpp"
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+using namespace SharedQueueFormat;
+
+namespace {
+    // Must match LogManager::queue
+    using Queue = LockFreeRingBuffer<QueuedMessage, QueueMode_enum::MPMC>;
+    using Slot = Queue::Slot;
+
+    constexpr size_t NAMES_OFFSET = sizeof(Header);
+    constexpr size_t SLOTS_OFFSET = NAMES_OFFSET + NAMES_BYTES;
+    static_assert(SLOTS_OFFSET % alignof(Slot) == 0, "Slots must be aligned inside the mapping");
+
+    // Recovery candidates are never overwritten: a crash loop keeps every one
+    constexpr int MAX_CRASH_COPIES = 100;
+
+    // Moves a predecessor's file that did not close cleanly, and so still
+    // holds undelivered records, to the first free "<path>.crash[.N]"
+    void preserveUnclean(int fd, const std::string& path) {
+        Header header;
+        if (pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+            std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+            header.state.load(std::memory_order_relaxed) == static_cast<uint32_t>(State::CLEAN)) {
+            return;
+        }
+        for (int copy = 0; copy < MAX_CRASH_COPIES; ++copy) {
+            std::string saved = path + CRASH_SUFFIX + (copy > 0 ? "." + std::to_string(copy) : "");
+            // link() fails with EEXIST instead of replacing an earlier copy
+            if (link(path.c_str(), saved.c_str()) == 0) {
+                unlink(path.c_str());
+                std::cerr << "Unclean shared queue kept as " << saved << ", see TeleLogRecover" << std::endl;
+                return;
+            }
+            if (errno != EEXIST) {
+                break;
+            }
+        }
+        throw std::runtime_error("Unclean shared queue could not be preserved, recover it first: " + path);
+    }
+
+    // Still the file at path, not one renamed or unlinked since it was opened
+    bool sameFile(int fd, const std::string& path) {
+        struct stat opened, current;
+        return fstat(fd, &opened) == 0 && stat(path.c_str(), &current) == 0 &&
+               opened.st_dev == current.st_dev && opened.st_ino == current.st_ino;
+    }
+
+    // Opens path holding an exclusive flock, the ownership test: the kernel
+    // drops it when the owner dies, whatever happens to its pid. A file left
+    // unclean is preserved first and a new one created in its place
+    int openOwned(const std::string& path) {
+        for (int attempt = 0; attempt < MAX_CRASH_COPIES; ++attempt) {
+            int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+            if (fd == -1) {
+                throw std::runtime_error("Failed to create shared queue: " + path);
+            }
+            if (flock(fd, LOCK_EX | LOCK_NB) == -1) {
+                Header header{};
+                bool known = pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                             std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0;
+                close(fd);
+                throw std::runtime_error("Shared queue in use" +
+                                         (known ? " by pid " + std::to_string(header.ownerPid) : std::string()) +
+                                         ": " + path);
+            }
+            if (!sameFile(fd, path)) {
+                close(fd);  // Lost a race with another manager moving or removing it
+                continue;
+            }
+            try {
+                preserveUnclean(fd, path);
+            } catch (...) {
+                close(fd);
+                throw;
+            }
+            if (sameFile(fd, path)) {
+                return fd;
+            }
+            close(fd);      // Moved to a .crash copy, start over with a new file
+        }
+        throw std::runtime_error("Failed to take over shared queue: " + path);
+    }
+}
+
+SharedQueueFile::SharedQueueFile(const std::string& path, size_t capacity) : path(path) {
+    size_t slotCount = Queue::roundUpPow2(capacity);
+    mappedBytes = SLOTS_OFFSET + Queue::storageBytes(capacity);
+    // Only the lock holder resets the file, so a live mapping is never truncated
+    fd = openOwned(path);
+    if (ftruncate(fd, 0) == -1 || ftruncate(fd, static_cast<off_t>(mappedBytes)) == -1) {
+        close(fd);
+        throw std::runtime_error("Failed to create shared queue: " + path);
+    }
+    // Populated up front so the first pushes do not fault pages in
+    base = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        throw std::runtime_error("Failed to map shared queue: " + path);
+    }
+
+    header = new (base) Header{};
+    std::memcpy(header->magic, MAGIC, sizeof(MAGIC));
+    header->version = VERSION;
+    header->headerBytes = sizeof(Header);
+    header->slotBytes = sizeof(Slot);
+    header->recordBytes = sizeof(QueuedMessage);
+    header->capacity = slotCount;
+    header->namesOffset = NAMES_OFFSET;
+    header->namesBytes = NAMES_BYTES;
+    header->slotsOffset = SLOTS_OFFSET;
+    header->createdNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    header->ownerPid = getpid();
+    header->namesUsed.store(0, std::memory_order_relaxed);
+    header->state.store(static_cast<uint32_t>(State::OPEN), std::memory_order_release);
+    names = static_cast<char*>(base) + NAMES_OFFSET;
+
+    syncNames();
+}
+
+SharedQueueFile::~SharedQueueFile() {
+    bool clean = header->state.load(std::memory_order_relaxed) == static_cast<uint32_t>(State::CLEAN);
+    munmap(base, mappedBytes);
+    // Unlinked while still locked; a manager that opened it meanwhile sees
+    // the inode is gone and starts over
+    if (clean) {
+        unlink(path.c_str());
+    }
+    close(fd);
+}
+
+void* SharedQueueFile::slotStorage() const {
+    return static_cast<char*>(base) + SLOTS_OFFSET;
+}
+
+void SharedQueueFile::appendName(NameKind kind, size_t id, std::string_view text) {
+    size_t used = header->namesUsed.load(std::memory_order_relaxed);
+    size_t length = std::min<size_t>(text.size(), 255);
+    if (used + NAME_ENTRY_HEADER + length > NAMES_BYTES) {
+        return; // Recovery shows these as "?"
+    }
+    char* entry = names + used;
+    entry[0] = static_cast<char>(kind);
+    uint16_t id16 = static_cast<uint16_t>(id);
+    std::memcpy(entry + 1, &id16, sizeof(id16));
+    entry[3] = static_cast<char>(length);
+    std::memcpy(entry + NAME_ENTRY_HEADER, text.data(), length);
+    header->namesUsed.store(static_cast<uint32_t>(used + NAME_ENTRY_HEADER + length), std::memory_order_release);
+}
+
+bool SharedQueueFile::namesStale() const {
+    return StringRegistry::size() != publishedStrings.load(std::memory_order_relaxed) ||
+           PolicyRegistry::size() != publishedPolicies.load(std::memory_order_relaxed);
+}
+
+void SharedQueueFile::syncNames() {
+    std::lock_guard<std::mutex> lock(namesMtx);
+    size_t strings = StringRegistry::size();
+    for (size_t id = publishedStrings.load(std::memory_order_relaxed); id < strings; ++id) {
+        appendName(NameKind::STRING, id, StringRegistry::lookup(static_cast<uint16_t>(id)));
+    }
+    publishedStrings.store(strings, std::memory_order_relaxed);
+
+    size_t policies = PolicyRegistry::size();
+    for (size_t id = publishedPolicies.load(std::memory_order_relaxed); id < policies; ++id) {
+        const PolicyInfo& policy = PolicyRegistry::lookup(static_cast<uint8_t>(id));
+        std::string text;
+        text.push_back(static_cast<char>(policy.message.precision));
+        text.push_back(static_cast<char>(std::min<size_t>(policy.unit.size(), 64)));
+        text.append(policy.unit.substr(0, 64));
+        text.append(policy.message.text);
+        appendName(NameKind::POLICY, id, text);
+    }
+    publishedPolicies.store(policies, std::memory_order_relaxed);
+}
+
+void SharedQueueFile::markClean() {
+    header->state.store(static_cast<uint32_t>(State::CLEAN), std::memory_order_release);
+}
+
+SharedQueueRecovery SharedQueueFile::recover(const std::string& path, std::vector<LogMessage>& out) {
+    SharedQueueRecovery result;
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat info;
+    if (fd == -1 || fstat(fd, &info) == -1 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        if (fd != -1) {
+            close(fd);
+        }
+        return result;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        return result;
+    }
+
+    const auto* header = static_cast<const Header*>(mapped);
+    const char* bytes = static_cast<const char*>(mapped);
+    bool layoutOk = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 && header->version == VERSION &&
+                    header->slotBytes == sizeof(Slot) && header->recordBytes == sizeof(QueuedMessage) &&
+                    header->capacity >= 2 && (header->capacity & (header->capacity - 1)) == 0 &&
+                    header->namesOffset + header->namesBytes <= size &&
+                    header->slotsOffset + header->capacity * sizeof(Slot) <= size &&
+                    header->slotsOffset % alignof(Slot) == 0;
+    if (!layoutOk) {
+        munmap(mapped, size);
+        return result;
+    }
+    result.valid = true;
+    result.cleanShutdown = header->state.load(std::memory_order_acquire) == static_cast<uint32_t>(State::CLEAN);
+    result.ownerPid = header->ownerPid;
+    result.capacity = header->capacity;
+
+    // Names the records refer to, mapped onto this process's registries
+    std::unordered_map<uint16_t, uint16_t> strings;
+    std::vector<uint8_t> policies(PolicyRegistry::MAX_POLICIES, PolicyRegistry::GENERIC_ID);
+    size_t used = std::min<size_t>(header->namesUsed.load(std::memory_order_acquire), header->namesBytes);
+    const char* entry = bytes + header->namesOffset;
+    const char* end = entry + used;
+    while (entry + NAME_ENTRY_HEADER <= end) {
+        uint16_t id;
+        std::memcpy(&id, entry + 1, sizeof(id));
+        size_t length = static_cast<uint8_t>(entry[3]);
+        if (entry + NAME_ENTRY_HEADER + length > end) {
+            break;
+        }
+        std::string text(entry + NAME_ENTRY_HEADER, length);
+        if (static_cast<NameKind>(entry[0]) == NameKind::STRING) {
+            strings[id] = StringRegistry::intern(text);
+        } else if (static_cast<NameKind>(entry[0]) == NameKind::POLICY && id < policies.size() &&
+                   id != PolicyRegistry::GENERIC_ID) {
+            size_t unitLength = text.size() >= 2 ? static_cast<uint8_t>(text[1]) : 0;
+            if (text.size() >= 2 + unitLength) {
+                policies[id] = PolicyRegistry::define(std::string_view(text).substr(2, unitLength),
+                                                      std::string_view(text).substr(2 + unitLength),
+                                                      static_cast<uint8_t>(text[0]));
+            }
+        }
+        entry += NAME_ENTRY_HEADER + length;
+    }
+    auto localString = [&strings](uint16_t id) {
+        auto found = strings.find(id);
+        return found != strings.end() ? found->second : StringRegistry::INVALID_ID;
+    };
+
+    // Committed and not released: sequence == ticket + 1 with ticket in this slot
+    const Slot* slots = reinterpret_cast<const Slot*>(bytes + header->slotsOffset);
+    const size_t mask = header->capacity - 1;
+    std::vector<std::pair<size_t, LogMessage>> committed;
+    for (size_t i = 0; i <= mask; ++i) {
+        size_t sequence = slots[i].sequence.load(std::memory_order_acquire);
+        if (sequence == 0 || ((sequence - 1) & mask) != i) {
+            continue;
+        }
+        QueuedMessage record;
+        std::memcpy(&record, slots[i].storage, sizeof(record));
+        committed.emplace_back(sequence - 1, record.toMessage());
+    }
+    std::sort(committed.begin(), committed.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (const auto& [ticket, record] : committed) {
+        auto timestamp = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::nanoseconds(record.getTimestampNs())));
+        LogMessage message(localString(record.getAppId()), localString(record.getContextId()),
+                           policies[record.getPolicyId()], record.getSeverity(), record.getValue(), timestamp);
+        if (record.getKind() == LogKind::REPEAT) {
+            message = LogMessage::repeat(message, record.getCount());
+        }
+        out.push_back(message);
+    }
+    result.committed = committed.size();
+
+    munmap(mapped, size);
+    return result;
+}
@@ -0,0 +1,71 @@
+#include "logger/StringRegistry.hpp"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace {
+    // Storage is split into lazily allocated chunks so that a published
+    // entry never moves and lookups need no lock
+    constexpr size_t CHUNK_BITS = 8;
+    constexpr size_t CHUNK_SIZE = size_t{1} << CHUNK_BITS;
+    constexpr size_t CHUNK_COUNT = (size_t{StringRegistry::INVALID_ID} + CHUNK_SIZE) / CHUNK_SIZE;
+
+    struct Chunk {
+        std::array<std::string, CHUNK_SIZE> entries;
+    };
+
+    struct Storage {
+        std::mutex mtx;
+        std::unordered_map<std::string, uint16_t> ids;
+        std::array<std::atomic<Chunk*>, CHUNK_COUNT> chunks{};
+        std::array<std::unique_ptr<Chunk>, CHUNK_COUNT> owned;
+        std::atomic<size_t> count{0};
+    };
+
+    Storage& storage() {
+        static Storage instance;
+        return instance;
+    }
+}
+
+uint16_t StringRegistry::intern(std::string_view text) {
+    Storage& s = storage();
+    std::lock_guard<std::mutex> lock(s.mtx);
+
+    std::string key(text);
+    auto found = s.ids.find(key);
+    if (found != s.ids.end()) {
+        return found->second;
+    }
+
+    size_t id = s.count.load(std::memory_order_relaxed);
+    if (id >= INVALID_ID) {
+        return INVALID_ID; // Registry exhausted
+    }
+
+    size_t chunkIndex = id >> CHUNK_BITS;
+    if (!s.owned[chunkIndex]) {
+        s.owned[chunkIndex] = std::make_unique<Chunk>();
+        s.chunks[chunkIndex].store(s.owned[chunkIndex].get(), std::memory_order_release);
+    }
+    s.owned[chunkIndex]->entries[id & (CHUNK_SIZE - 1)] = key;
+    s.ids.emplace(std::move(key), static_cast<uint16_t>(id));
+    s.count.store(id + 1, std::memory_order_release);
+    return static_cast<uint16_t>(id);
+}
+
+std::string_view StringRegistry::lookup(uint16_t id) {
+    Storage& s = storage();
+    if (id >= s.count.load(std::memory_order_acquire)) {
+        return "?";
+    }
+    const Chunk* chunk = s.chunks[id >> CHUNK_BITS].load(std::memory_order_acquire);
+    return chunk->entries[id & (CHUNK_SIZE - 1)];
+}
+
+size_t StringRegistry::size() {
+    return storage().count.load(std::memory_order_acquire);
+}
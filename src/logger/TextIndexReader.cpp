@@ -0,0 +1,180 @@
+#include "logger/TextIndexReader.hpp"
+#include <fcntl.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace TextIndexFormat;
+
+namespace {
+    constexpr size_t READ_CHUNK = 1 << 20;
+
+    void addRegion(std::vector<TextRegion>& regions, uint64_t offset, uint64_t bytes, bool indexed) {
+        if (bytes == 0) {
+            return;
+        }
+        if (!regions.empty()) {
+            TextRegion& last = regions.back();
+            if (last.offset + last.bytes == offset && last.indexed == indexed) {
+                last.bytes += bytes;
+                return;
+            }
+        }
+        regions.push_back(TextRegion{offset, bytes, indexed});
+    }
+}
+
+TextIndexReader::TextIndexReader(const std::string& logPath) : file(logPath, O_RDONLY) {
+    if (!file.Size(fileSize)) {
+        return;
+    }
+    loadIndex(logPath + INDEX_SUFFIX);
+}
+
+void TextIndexReader::loadIndex(const std::string& indexPath) {
+    SafeFd index(indexPath, O_RDONLY);
+    uint64_t indexSize = 0;
+    std::string data;
+    if (index.Size(indexSize)) {
+        data.resize(static_cast<size_t>(indexSize));
+        if (!index.ReadAt(data.data(), data.size(), 0)) {
+            data.clear();
+        }
+    }
+    if (data.size() < MAGIC_SIZE || std::memcmp(data.data(), INDEX_MAGIC, MAGIC_SIZE) != 0) {
+        return;
+    }
+    indexLoaded = true;
+
+    // A torn or unknown record ends the index; the text after it is scanned
+    size_t pos = MAGIC_SIZE;
+    std::vector<std::string> bitNames;
+    while (pos < data.size()) {
+        auto type = static_cast<RecordType>(data[pos]);
+        const char* body = data.data() + pos + 1;
+        size_t left = data.size() - pos - 1;
+
+        if (type == RecordType::SESSION && left >= sizeof(Session)) {
+            Session session;
+            std::memcpy(&session, body, sizeof(session));
+            // A session starting below covered text means the log was truncated
+            // or rotated by copytruncate; the earlier summaries describe text
+            // that is gone
+            if (!entries.empty() &&
+                session.startOffset < entries.back().checkpoint.offset + entries.back().checkpoint.bytes) {
+                entries.clear();
+            }
+            SessionInfo info;
+            info.renderOptions.utc = session.utc != 0;
+            info.renderOptions.subSecondDigits = session.subSecondDigits;
+            sessions.push_back(std::move(info));
+            pos += 1 + sizeof(Session);
+        } else if (type == RecordType::CONTEXT && left >= 2 && left >= size_t{2} + static_cast<uint8_t>(body[1]) &&
+                   !sessions.empty()) {
+            uint8_t bit = static_cast<uint8_t>(body[0]);
+            uint8_t length = static_cast<uint8_t>(body[1]);
+            sessions.back().contextBits[std::string(body + 2, length)] = bit;
+            pos += 3 + length;
+        } else if (type == RecordType::CHECKPOINT && left >= sizeof(Checkpoint) && !sessions.empty()) {
+            Checkpoint checkpoint;
+            std::memcpy(&checkpoint, body, sizeof(checkpoint));
+            pos += 1 + sizeof(Checkpoint);
+
+            // Must lie inside the log and after the previous checkpoint
+            uint64_t end = checkpoint.offset + checkpoint.bytes;
+            uint64_t previousEnd = entries.empty() ? 0
+                : entries.back().checkpoint.offset + entries.back().checkpoint.bytes;
+            if (end <= fileSize && checkpoint.offset >= previousEnd) {
+                entries.push_back(Entry{checkpoint, sessions.size() - 1});
+            }
+        } else {
+            break;
+        }
+    }
+}
+
+bool TextIndexReader::isValid() const {
+    return file.IsOpen();
+}
+
+bool TextIndexReader::hasIndex() const {
+    return indexLoaded;
+}
+
+size_t TextIndexReader::checkpoints() const {
+    return entries.size();
+}
+
+uint64_t TextIndexReader::logBytes() const {
+    return fileSize;
+}
+
+uint64_t TextIndexReader::indexedBytes() const {
+    uint64_t total = 0;
+    for (const Entry& entry : entries) {
+        total += entry.checkpoint.bytes;
+    }
+    return total;
+}
+
+RenderOptions TextIndexReader::renderOptions() const {
+    return sessions.empty() ? RenderOptions{} : sessions.back().renderOptions;
+}
+
+bool TextIndexReader::matches(const Entry& entry, const TextIndexQuery& query) const {
+    const Checkpoint& checkpoint = entry.checkpoint;
+    if (checkpoint.maxTimestampNs < query.fromNs || checkpoint.minTimestampNs > query.toNs) {
+        return false;
+    }
+    if ((checkpoint.severityMask & query.severityMask) == 0) {
+        return false;
+    }
+    if (query.context.empty()) {
+        return true;
+    }
+    const auto& bits = sessions[entry.session].contextBits;
+    auto it = bits.find(query.context);
+    uint8_t bit = it != bits.end() ? it->second : OVERFLOW_BIT;
+    return (checkpoint.contextMask >> bit) & 1;
+}
+
+std::vector<TextRegion> TextIndexReader::select(const TextIndexQuery& query) const {
+    std::vector<TextRegion> regions;
+    uint64_t covered = 0;
+    for (const Entry& entry : entries) {
+        const Checkpoint& checkpoint = entry.checkpoint;
+        addRegion(regions, covered, checkpoint.offset - covered, false);
+        if (matches(entry, query)) {
+            addRegion(regions, checkpoint.offset, checkpoint.bytes, true);
+        }
+        covered = checkpoint.offset + checkpoint.bytes;
+    }
+    addRegion(regions, covered, fileSize - covered, false);
+    return regions;
+}
+
+bool TextIndexReader::forEachLine(const TextRegion& region,
+                                  const std::function<void(std::string_view)>& handler) {
+    uint64_t offset = region.offset;
+    uint64_t end = region.offset + region.bytes;
+    chunk.clear();
+
+    while (offset < end) {
+        size_t carried = chunk.size();
+        size_t want = static_cast<size_t>(std::min<uint64_t>(READ_CHUNK, end - offset));
+        chunk.resize(carried + want);
+        if (!file.ReadAt(chunk.data() + carried, want, offset)) {
+            return false;
+        }
+        offset += want;
+
+        std::string_view rest(chunk);
+        size_t newline;
+        while ((newline = rest.find('\n')) != std::string_view::npos) {
+            handler(rest.substr(0, newline));
+            rest.remove_prefix(newline + 1);
+        }
+        // Keep an unfinished line for the next chunk; one cut by end is dropped
+        chunk.erase(0, chunk.size() - rest.size());
+    }
+    return true;
+}
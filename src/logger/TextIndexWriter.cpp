@@ -0,0 +1,140 @@
+#include "logger/TextIndexWriter.hpp"
+#include "logger/StringRegistry.hpp"
+#include <fcntl.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <stdexcept>
+
+using namespace TextIndexFormat;
+
+TextIndexWriter::TextIndexWriter(const std::string& indexPath, uint64_t dataOffset, bool truncate,
+                                 size_t checkpointBytes, RenderOptions renderOptions)
+    : checkpointBytes(checkpointBytes == 0 ? 1 : checkpointBytes) {
+    // An empty log (opened with out or trunc, or emptied by copytruncate)
+    // makes every older checkpoint stale
+    bool restart = truncate || dataOffset == 0;
+    int flags = O_RDWR | O_CREAT | O_APPEND | (restart ? O_TRUNC : 0);
+    file = SafeFd(indexPath, flags);
+    if (!file.IsOpen() || !file.Size(written)) {
+        throw std::runtime_error("Failed to open index: " + indexPath);
+    }
+    if (written > 0) {
+        repairTail();
+    }
+    if (written == 0) {
+        pending.append(INDEX_MAGIC, MAGIC_SIZE);
+    }
+
+    Session session{};
+    session.startOffset = dataOffset;
+    session.utc = renderOptions.utc ? 1 : 0;
+    session.subSecondDigits = static_cast<uint8_t>(renderOptions.subSecondDigits);
+    put(RecordType::SESSION, &session, sizeof(session));
+    flush();
+
+    current.offset = dataOffset;
+}
+
+void TextIndexWriter::repairTail() {
+    // Indexes are small next to their logs, read it whole like the reader
+    std::string data(static_cast<size_t>(written), '\0');
+    uint64_t end = 0;
+    if (file.ReadAt(data.data(), data.size(), 0) && data.size() >= MAGIC_SIZE &&
+        std::memcmp(data.data(), INDEX_MAGIC, MAGIC_SIZE) == 0) {
+        end = MAGIC_SIZE;
+        while (size_t size = recordSize(data.data() + end, data.size() - end)) {
+            end += size;
+        }
+    }
+    if (end == written) {
+        return;
+    }
+    // A record torn by a crash would misalign everything appended after it;
+    // without a valid magic the index starts over
+    std::cerr << "FileSink index: dropping " << written - end << " torn bytes" << std::endl;
+    if (!file.Truncate(end)) {
+        throw std::runtime_error("Failed to repair index");
+    }
+    written = end;
+}
+
+TextIndexWriter::~TextIndexWriter() {
+    closeCheckpoint();
+    flush();
+}
+
+void TextIndexWriter::put(RecordType type, const void* body, size_t size) {
+    pending.push_back(static_cast<char>(type));
+    pending.append(static_cast<const char*>(body), size);
+}
+
+uint8_t TextIndexWriter::bitFor(uint16_t contextId) {
+    if (contextId >= contextBits.size()) {
+        contextBits.resize(static_cast<size_t>(contextId) + 1, NO_BIT);
+    }
+    uint8_t& bit = contextBits[contextId];
+    if (bit != NO_BIT) {
+        return bit;
+    }
+    if (nextBit == OVERFLOW_BIT) {
+        bit = OVERFLOW_BIT;
+        return bit;
+    }
+
+    // Declared before the first checkpoint that uses it
+    std::string_view name = StringRegistry::lookup(contextId);
+    uint8_t header[2] = {nextBit, static_cast<uint8_t>(std::min<size_t>(name.size(), 255))};
+    pending.push_back(static_cast<char>(RecordType::CONTEXT));
+    pending.append(reinterpret_cast<const char*>(header), sizeof(header));
+    pending.append(name.data(), header[1]);
+    bit = nextBit++;
+    return bit;
+}
+
+void TextIndexWriter::record(const LogMessage& msg, size_t lineBytes) {
+    int64_t timestamp = msg.getTimestampNs();
+    if (current.records == 0) {
+        current.minTimestampNs = timestamp;
+        current.maxTimestampNs = timestamp;
+    } else {
+        current.minTimestampNs = std::min(current.minTimestampNs, timestamp);
+        current.maxTimestampNs = std::max(current.maxTimestampNs, timestamp);
+    }
+    current.severityMask |= static_cast<uint8_t>(1u << (static_cast<unsigned>(msg.getSeverity()) & 7));
+    current.contextMask |= uint64_t{1} << bitFor(msg.getContextId());
+    current.bytes += static_cast<uint32_t>(lineBytes);
+    ++current.records;
+
+    if (current.bytes >= checkpointBytes) {
+        closeCheckpoint();
+    }
+}
+
+void TextIndexWriter::closeCheckpoint() {
+    if (current.records == 0) {
+        return;
+    }
+    put(RecordType::CHECKPOINT, &current, sizeof(current));
+    uint64_t next = current.offset + current.bytes;
+    current = Checkpoint{};
+    current.offset = next;
+}
+
+void TextIndexWriter::flush() {
+    if (pending.empty()) {
+        return;
+    }
+    if (file.WriteAll(pending.data(), pending.size())) {
+        written += pending.size();
+    } else {
+        // Readers fall back to scanning the text the lost records covered;
+        // a torn record would end the index early, so cut it off
+        std::cerr << "FileSink index write failed" << std::endl;
+        if (!file.Truncate(written)) {
+            file.Size(written);
+        }
+    }
+    pending.clear();
+}
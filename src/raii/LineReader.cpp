@@ -0,0 +1,111 @@
+#include "raii/LineReader.hpp"
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+LineReader::LineReader(size_t chunkSize, size_t maxLine)
+    : maxLine(maxLine > 0 ? maxLine : DEFAULT_MAX_LINE) {
+    // Never larger than the longest line plus its '\n', so no longer line fits
+    buffer.resize(std::min(chunkSize > 0 ? chunkSize : DEFAULT_CHUNK, this->maxLine + 1));
+}
+
+bool LineReader::fill(int fd){
+    if(eof || fd == -1){
+        return false;
+    }
+
+    // Move the pending partial line to the front, grow if it fills the buffer
+    if(begin > 0){
+        std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+    }
+    if(end > maxLine){
+        // No '\n' within maxLine: drop what arrived and skip to the next one
+        ++dropped;
+        discarding = true;
+        end = 0;
+    }
+    if(end == buffer.size()){
+        buffer.resize(std::min(buffer.size() * 2, maxLine + 1));
+    }
+
+    while(true){
+        ssize_t count = read(fd, buffer.data() + end, buffer.size() - end);
+        if(count > 0){
+            end += static_cast<size_t>(count);
+            return true;
+        }
+        if(count == -1 && errno == EINTR){
+            continue;
+        }
+        if(count == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)){
+            return false; // Non-blocking descriptor with nothing to read yet
+        }
+        eof = true; // Orderly shutdown or hard error
+        return false;
+    }
+}
+
+bool LineReader::splitLine(std::string_view& line){
+    if(discarding){
+        const void* newline = std::memchr(buffer.data() + begin, '\n', end - begin);
+        if(newline == nullptr){
+            begin = end;
+            return false;
+        }
+        begin = static_cast<size_t>(static_cast<const char*>(newline) - buffer.data()) + 1;
+        discarding = false;
+    }
+    const char* start = buffer.data() + begin;
+    const void* newline = std::memchr(start, '\n', end - begin);
+    if(newline != nullptr){
+        size_t length = static_cast<const char*>(newline) - start;
+        line = std::string_view(start, length);
+        begin += length + 1;
+        return true;
+    }
+    if(eof && begin < end){
+        line = std::string_view(start, end - begin);
+        begin = end;
+        return true;
+    }
+    return false;
+}
+
+bool LineReader::nextLine(int fd, std::string_view& line){
+    while(!splitLine(line)){
+        if(!fill(fd)){
+            return splitLine(line);
+        }
+    }
+    return true;
+}
+
+bool LineReader::readAvailableLines(int fd, std::vector<std::string_view>& lines){
+    lines.clear();
+
+    // Only refill once all buffered lines were handed out, so views stay valid
+    std::string_view line;
+    while(lines.empty()){
+        while(splitLine(line)){
+            lines.push_back(line);
+        }
+        if(!lines.empty() || !fill(fd)){
+            break;
+        }
+    }
+    while(lines.empty() && splitLine(line)){
+        lines.push_back(line);
+    }
+    return !lines.empty();
+}
+
+bool LineReader::atEof() const{
+    return eof && begin == end;
+}
+
+uint64_t LineReader::droppedLines() const{
+    return dropped;
+}
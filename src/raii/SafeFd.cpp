@@ -0,0 +1,93 @@
+#include "raii/SafeFd.hpp"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+
+constexpr int NOT_OPEN = -1;
+
+SafeFd::SafeFd(): fd{NOT_OPEN}{
+}
+
+SafeFd::SafeFd(const std::string &RefFilePath, int flags, mode_t mode){
+    fd = open(RefFilePath.c_str(), flags | O_CLOEXEC, mode);
+}
+
+SafeFd::SafeFd(SafeFd&& other) noexcept: fd{other.fd}{
+    other.fd = NOT_OPEN; //prevents the Double Close
+}
+
+SafeFd& SafeFd::operator=(SafeFd&& other)noexcept{
+    if(this != &other){
+        if(fd != NOT_OPEN){
+            close(fd);
+        }
+        fd = other.fd;
+        other.fd = NOT_OPEN;
+    }
+    return *this;
+}
+
+bool SafeFd::IsOpen() const{
+    return fd != NOT_OPEN;
+}
+
+int SafeFd::GetFd() const{
+    return fd;
+}
+
+bool SafeFd::WriteAll(const void* data, size_t size){
+    const char* pos = static_cast<const char*>(data);
+    while(size > 0){
+        ssize_t written = ::write(fd, pos, size);
+        if(written < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            return false;
+        }
+        pos += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool SafeFd::ReadAt(void* out, size_t size, uint64_t offset) const{
+    char* pos = static_cast<char*>(out);
+    while(size > 0){
+        ssize_t got = pread(fd, pos, size, static_cast<off_t>(offset));
+        if(got < 0 && errno == EINTR){
+            continue;
+        }
+        if(got <= 0){
+            return false;
+        }
+        pos += got;
+        size -= static_cast<size_t>(got);
+        offset += static_cast<uint64_t>(got);
+    }
+    return true;
+}
+
+bool SafeFd::Size(uint64_t& size) const{
+    struct stat info;
+    if(fd == NOT_OPEN || fstat(fd, &info) == -1){
+        return false;
+    }
+    size = static_cast<uint64_t>(info.st_size);
+    return true;
+}
+
+bool SafeFd::Truncate(uint64_t size){
+    int result;
+    do{
+        result = ftruncate(fd, static_cast<off_t>(size));
+    }while(result == -1 && errno == EINTR);
+    return result == 0;
+}
+
+SafeFd::~SafeFd(){
+    if(fd != NOT_OPEN){
+        close(fd);
+    }
+}
@@ -1,12 +1,13 @@
 #include "raii/SafeFile.hpp"
 #include <fcntl.h>   
 #include <unistd.h>  
+#include <cerrno>
 #include <iostream>
 
 
 constexpr int FAILED_TO_OPEN = -1;
 
-SafeFile::SafeFile(SafeFile&& other) noexcept: filefd{other.filefd}{
+SafeFile::SafeFile(SafeFile&& other) noexcept: filefd{other.filefd}, reader{std::move(other.reader)}{
     other.filefd = -1; //prevents the Double Close
 }
 
@@ -16,6 +17,7 @@ SafeFile& SafeFile::operator=(SafeFile&& other)noexcept{
             close(filefd);
         }
         filefd = other.filefd;
+        reader = std::move(other.reader);
         other.filefd = -1;
     }
     return *this;
@@ -35,19 +37,71 @@ bool SafeFile::IsOpen(){
 }
 
 std::string SafeFile::Read(){
-    std::string returnString="";
-    
-    if(filefd != FAILED_TO_OPEN){
-        char ch;
-        // Read one character at a time until newline or EOF
-        while (read(filefd, &ch, 1) == 1) {
-            if (ch == '\n') {
-                break;
+    std::string_view line;
+    if(ReadLine(line)){
+        return std::string(line);
+    }
+    return "";
+}
+
+bool SafeFile::ReadLine(std::string_view& line){
+    if(filefd == FAILED_TO_OPEN){
+        return false;
+    }
+    return reader.nextLine(filefd, line);
+}
+
+bool SafeFile::ReadLines(std::vector<std::string_view>& lines){
+    if(filefd == FAILED_TO_OPEN){
+        lines.clear();
+        return false;
+    }
+    return reader.readAvailableLines(filefd, lines);
+}
+
+bool SafeFile::Snapshot(std::vector<char>& buffer, std::string_view& content){
+    if(filefd == FAILED_TO_OPEN){
+        return false;
+    }
+    if(buffer.empty()){
+        buffer.resize(4096);
+    }
+    while(true){
+        // A single pread: proc files are generated in one go and a second
+        // read at a later offset could see a different snapshot
+        ssize_t got = pread(filefd, buffer.data(), buffer.size(), 0);
+        if(got < 0){
+            if(errno == EINTR){
+                continue;
             }
-            returnString += ch;
+            return false;
+        }
+        if(static_cast<size_t>(got) < buffer.size()){
+            content = std::string_view(buffer.data(), static_cast<size_t>(got));
+            return true;
         }
+        buffer.resize(buffer.size() * 2);
+    }
+}
+
+bool SafeFile::AtEof() const{
+    return reader.atEof();
+}
+
+uint64_t SafeFile::DroppedLines() const{
+    return reader.droppedLines();
+}
+
+int SafeFile::GetFd() const{
+    return filefd;
+}
+
+bool SafeFile::SetNonBlocking(){
+    if(filefd == FAILED_TO_OPEN){
+        return false;
     }
-    return(returnString);
+    int flags = fcntl(filefd, F_GETFL, 0);
+    return flags != -1 && fcntl(filefd, F_SETFL, flags | O_NONBLOCK) != -1;
 }
 
 SafeFile::~SafeFile(){
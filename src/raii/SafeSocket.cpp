@@ -4,13 +4,16 @@
 #include <sys/socket.h>
 #include <cstring>
 #include <sys/un.h>
+#include <sys/uio.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
 
 constexpr int FAILED_TO_OPEN = -1;
 constexpr int FAILED_TO_CONNECT = -1;
 
 
-SafeSocket::SafeSocket(SafeSocket&& other) noexcept : socketfd{other.socketfd} { 
+SafeSocket::SafeSocket(SafeSocket&& other) noexcept : socketfd{other.socketfd}, reader{std::move(other.reader)} { 
     other.socketfd = -1;        
 }
 
@@ -21,6 +24,7 @@ SafeSocket& SafeSocket::operator=(SafeSocket&& other) noexcept {
             close(socketfd); // Close our own current resource first
         }
         socketfd = other.socketfd;           // Steal the new one
+        reader = std::move(other.reader);    // Along with any buffered input
         other.socketfd = -1;                 // Nullify the old one
     }
     return *this;
@@ -49,23 +53,119 @@ SafeSocket::SafeSocket(const std::string &RefFilePath){
 }
 
 
+SafeSocket::SafeSocket(AdoptFd, int fd) : socketfd{fd} {
+}
+
+SafeSocket SafeSocket::Listen(const std::string &RefFilePath, int backlog){
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == FAILED_TO_OPEN) {
+        return SafeSocket(AdoptFd{}, FAILED_TO_OPEN);
+    }
+
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, RefFilePath.c_str(), sizeof(addr.sun_path) - 1);
+
+    unlink(RefFilePath.c_str()); // Leftover from a previous run
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == -1 ||
+        listen(fd, backlog) == -1) {
+        std::cerr << "Failed to listen on: " << RefFilePath << std::endl;
+        close(fd);
+        fd = FAILED_TO_OPEN;
+    }
+    return SafeSocket(AdoptFd{}, fd);
+}
+
+SafeSocket SafeSocket::Accept(){
+    if (socketfd == FAILED_TO_OPEN) {
+        return SafeSocket(AdoptFd{}, FAILED_TO_OPEN);
+    }
+    int fd = accept4(socketfd, nullptr, nullptr, SOCK_CLOEXEC);
+    return SafeSocket(AdoptFd{}, fd == -1 ? FAILED_TO_OPEN : fd);
+}
+
+SafeSocket SafeSocket::ConnectNonBlocking(const std::string &RefFilePath){
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd == FAILED_TO_OPEN) {
+        return SafeSocket(AdoptFd{}, FAILED_TO_OPEN);
+    }
+
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, RefFilePath.c_str(), sizeof(addr.sun_path) - 1);
+
+    // AF_UNIX connects complete immediately or fail (EAGAIN: backlog full)
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == FAILED_TO_CONNECT) {
+        close(fd);
+        fd = FAILED_TO_OPEN;
+    }
+    return SafeSocket(AdoptFd{}, fd);
+}
+
+ssize_t SafeSocket::SendV(const struct iovec* buffers, int count){
+    if (socketfd == FAILED_TO_OPEN) {
+        errno = EBADF;
+        return -1;
+    }
+    struct msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov = const_cast<struct iovec*>(buffers);
+    message.msg_iovlen = static_cast<size_t>(count);
+
+    ssize_t sent;
+    do {
+        sent = sendmsg(socketfd, &message, MSG_NOSIGNAL);
+    } while (sent == -1 && errno == EINTR);
+    return sent;
+}
+
+bool SafeSocket::AtEof() const{
+    return reader.atEof();
+}
+
+uint64_t SafeSocket::DroppedLines() const{
+    return reader.droppedLines();
+}
+
+int SafeSocket::GetFd() const{
+    return socketfd;
+}
+
+bool SafeSocket::SetNonBlocking(){
+    if (socketfd == FAILED_TO_OPEN) {
+        return false;
+    }
+    int flags = fcntl(socketfd, F_GETFL, 0);
+    return flags != -1 && fcntl(socketfd, F_SETFL, flags | O_NONBLOCK) != -1;
+}
+
 bool SafeSocket::IsOpen(){
     return(socketfd != FAILED_TO_OPEN);
 }
 
 std::string SafeSocket::Read(){
-    std::string returnString="";
+    std::string_view line;
+    if(ReadLine(line)){
+        return std::string(line);
+    }
+    return "";
+}
 
-    if(socketfd != FAILED_TO_OPEN){
-        char ch;
-        while (read(socketfd,&ch,1)==1){
-            if(ch == '\n'){
-                break;
-            }
-            returnString += ch;
-        }
+bool SafeSocket::ReadLine(std::string_view& line){
+    if(socketfd == FAILED_TO_OPEN){
+        return false;
+    }
+    return reader.nextLine(socketfd, line);
+}
+
+bool SafeSocket::ReadLines(std::vector<std::string_view>& lines){
+    if(socketfd == FAILED_TO_OPEN){
+        lines.clear();
+        return false;
     }
-    return(returnString);
+    return reader.readAvailableLines(socketfd, lines);
 }
 
 SafeSocket::~SafeSocket(){
@@ -0,0 +1,189 @@
+#include "sink/BinarySinkImpl.hpp"
+#include "logger/BinaryLogFormat.hpp"
+#include "logger/StringRegistry.hpp"
+#include "logger/PolicyRegistry.hpp"
+#include <fcntl.h>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace BinaryLogFormat;
+
+namespace {
+    constexpr size_t SCAN_CHUNK = 64 * 1024;
+
+    // End of the last whole record, found by walking the length prefixes in
+    // one sequential read; a record torn by a crash ends the walk
+    uint64_t wholeRecordsEnd(const SafeFd& file, uint64_t size) {
+        std::vector<unsigned char> chunk(SCAN_CHUNK);
+        uint64_t chunkStart = 0;
+        size_t chunkSize = 0;
+        uint64_t offset = HEADER_SIZE;
+        while (offset < size) {
+            if (offset + MAX_VARINT_BYTES > chunkStart + chunkSize && chunkStart + chunkSize < size) {
+                chunkStart = offset;
+                chunkSize = static_cast<size_t>(std::min<uint64_t>(SCAN_CHUNK, size - offset));
+                if (!file.ReadAt(chunk.data(), chunkSize, chunkStart)) {
+                    break;
+                }
+            }
+            Reader in{chunk.data() + (offset - chunkStart), chunk.data() + chunkSize};
+            uint64_t length;
+            if (!in.varint(length) || length > MAX_RECORD_BYTES) {
+                break;
+            }
+            uint64_t next = chunkStart + static_cast<uint64_t>(in.pos - chunk.data()) + length;
+            if (next > size) {
+                break;
+            }
+            offset = next;
+        }
+        return std::min(offset, size);
+    }
+}
+
+BinarySink::BinarySink(const std::string& filePath)
+    : file(filePath, O_RDWR | O_CREAT | O_APPEND), knownPolicies(PolicyRegistry::MAX_POLICIES, false) {
+    if (!file.IsOpen() || !file.Size(fileSize)) {
+        throw std::runtime_error("Failed to open file: " + filePath);
+    }
+
+    // New file (or one torn inside the header): write the header
+    if (fileSize < HEADER_SIZE) {
+        if (!file.Truncate(0)) {
+            throw std::runtime_error("Failed to reset file: " + filePath);
+        }
+        fileSize = 0;
+        buffer.append(MAGIC, sizeof(MAGIC));
+        putFixed<uint16_t>(buffer, VERSION);
+        putFixed<uint16_t>(buffer, 0);
+        flushBuffer();
+        return;
+    }
+
+    // Existing file: this session re-emits its dictionary, after the last
+    // whole record so a crash mid-record does not shift everything after it
+    char header[sizeof(MAGIC)];
+    if (!file.ReadAt(header, sizeof(header), 0) || std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a binary log: " + filePath);
+    }
+    uint64_t end = wholeRecordsEnd(file, fileSize);
+    if (end != fileSize) {
+        std::cerr << "BinarySink dropping " << fileSize - end << " torn bytes" << std::endl;
+        if (!file.Truncate(end)) {
+            throw std::runtime_error("Failed to repair file: " + filePath);
+        }
+        fileSize = end;
+    }
+}
+
+void BinarySink::beginRecord() {
+    payload.clear();
+}
+
+void BinarySink::endRecord() {
+    putVarint(buffer, payload.size());
+    buffer += payload;
+}
+
+void BinarySink::defineString(uint16_t id) {
+    if (id >= knownStrings.size()) {
+        knownStrings.resize(static_cast<size_t>(id) + 1, false);
+    }
+    if (knownStrings[id]) {
+        return;
+    }
+    knownStrings[id] = true;
+
+    std::string_view text = StringRegistry::lookup(id).substr(0, MAX_TEXT_BYTES);
+    beginRecord();
+    payload.push_back(static_cast<char>(RecordType::STRING));
+    putVarint(payload, id);
+    putVarint(payload, text.size());
+    payload.append(text.data(), text.size());
+    endRecord();
+}
+
+void BinarySink::definePolicy(uint8_t id) {
+    if (knownPolicies[id]) {
+        return;
+    }
+    knownPolicies[id] = true;
+
+    const PolicyInfo& policy = PolicyRegistry::lookup(id);
+    std::string_view unit = std::string_view(policy.unit).substr(0, MAX_TEXT_BYTES / 2);
+    std::string_view text = std::string_view(policy.message.text).substr(0, MAX_TEXT_BYTES / 2);
+    beginRecord();
+    payload.push_back(static_cast<char>(RecordType::POLICY));
+    payload.push_back(static_cast<char>(id));
+    putVarint(payload, unit.size());
+    payload.append(unit.data(), unit.size());
+    payload.push_back(static_cast<char>(policy.message.precision));
+    putVarint(payload, text.size());
+    payload.append(text.data(), text.size());
+    endRecord();
+}
+
+void BinarySink::encode(const LogMessage& log) {
+    if (!haveTimeBase) {
+        beginRecord();
+        payload.push_back(static_cast<char>(RecordType::TIME_BASE));
+        putFixed<int64_t>(payload, log.getTimestampNs());
+        endRecord();
+        lastTimestampNs = log.getTimestampNs();
+        haveTimeBase = true;
+    }
+    defineString(log.getAppId());
+    defineString(log.getContextId());
+    definePolicy(log.getPolicyId());
+
+    bool aggregate = log.getKind() != LogKind::SAMPLE;
+    beginRecord();
+    payload.push_back(static_cast<char>(aggregate ? RecordType::AGGREGATE : RecordType::LOG));
+    putVarint(payload, zigzag(log.getTimestampNs() - lastTimestampNs));
+    payload.push_back(static_cast<char>(log.getSeverity()));
+    putVarint(payload, log.getAppId());
+    putVarint(payload, log.getContextId());
+    payload.push_back(static_cast<char>(log.getPolicyId()));
+    putFixed<float>(payload, log.getValue());
+    if (aggregate) {
+        payload.push_back(static_cast<char>(log.getKind()));
+        putVarint(payload, log.getCount());
+        putFixed<float>(payload, log.getMinValue());
+        putFixed<float>(payload, log.getMaxValue());
+        putFixed<float>(payload, log.getMeanValue());
+    }
+    endRecord();
+
+    lastTimestampNs = log.getTimestampNs();
+}
+
+void BinarySink::flushBuffer() {
+    if (file.WriteAll(buffer.data(), buffer.size())) {
+        fileSize += buffer.size();
+    } else {
+        std::cerr << "BinarySink write failed, dropping " << buffer.size() << " bytes" << std::endl;
+        // Cut a partial write off and start a fresh dictionary, the lost
+        // bytes may have held entries later records rely on
+        if (!file.Truncate(fileSize)) {
+            file.Size(fileSize);
+        }
+        std::fill(knownStrings.begin(), knownStrings.end(), false);
+        std::fill(knownPolicies.begin(), knownPolicies.end(), false);
+        haveTimeBase = false;
+    }
+    buffer.clear();
+}
+
+void BinarySink::write(const LogMessage& log) {
+    encode(log);
+    flushBuffer();
+}
+
+void BinarySink::writeBatch(const std::vector<LogMessage>& batch) {
+    for (const auto& log : batch) {
+        encode(log);
+    }
+    flushBuffer();
+}
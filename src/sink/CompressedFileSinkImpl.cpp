@@ -0,0 +1,258 @@
+#include "sink/CompressedFileSinkImpl.hpp"
+#include "logger/BlockLogFormat.hpp"
+#include <fcntl.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#ifdef TELELOG_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace BlockLogFormat;
+
+namespace {
+    // Opens for appending and writes the magic into a new file (or one torn
+    // inside the magic); size is the file size afterwards. Not open on failure.
+    SafeFd openWithMagic(const std::string& path, const char* magic, uint64_t& size) {
+        SafeFd file(path, O_RDWR | O_CREAT | O_APPEND);
+        if (!file.IsOpen() || !file.Size(size)) {
+            return SafeFd();
+        }
+        if (size < MAGIC_SIZE) {
+            if (!file.Truncate(0) || !file.WriteAll(magic, MAGIC_SIZE)) {
+                return SafeFd();
+            }
+            size = MAGIC_SIZE;
+        }
+        return file;
+    }
+}
+
+CompressedFileSink::CompressedFileSink(const std::string& filePath, CompressedFileSinkConfig config)
+    : config(config), renderer(config.renderOptions), currentOpened(std::chrono::steady_clock::now()) {
+    this->config.blockBytes = std::clamp<size_t>(this->config.blockBytes, 1, MAX_RAW_BYTES - LogRenderer::MAX_LINE);
+    if (this->config.maxPendingBlocks == 0) {
+        this->config.maxPendingBlocks = 1;
+    }
+
+    uint64_t indexSize = 0;
+    dataFile = openWithMagic(filePath, DATA_MAGIC, dataOffset);
+    if (dataFile.IsOpen()) {
+        indexFile = openWithMagic(filePath + INDEX_SUFFIX, INDEX_MAGIC, indexSize);
+    }
+    if (!dataFile.IsOpen() || !indexFile.IsOpen()) {
+        throw std::runtime_error("Failed to open file: " + filePath);
+    }
+    repairTail(indexSize);
+
+    current.text.reserve(this->config.blockBytes + LogRenderer::MAX_LINE);
+    compressor = std::thread(&CompressedFileSink::compressLoop, this);
+}
+
+void CompressedFileSink::repairTail(uint64_t indexSize) {
+    // Keep whole index entries that describe blocks inside the data file
+    uint64_t indexed = indexSize > MAGIC_SIZE ? (indexSize - MAGIC_SIZE) / sizeof(IndexEntry) : 0;
+    uint64_t offset = MAGIC_SIZE;
+    IndexEntry entry{};
+    while (indexed > 0) {
+        if (indexFile.ReadAt(&entry, sizeof(entry), MAGIC_SIZE + (indexed - 1) * sizeof(IndexEntry)) &&
+            plausible(entry.header) && entry.offset >= MAGIC_SIZE &&
+            entry.offset + sizeof(BlockHeader) + entry.header.storedBytes <= dataOffset) {
+            offset = entry.offset + sizeof(BlockHeader) + entry.header.storedBytes;
+            break;
+        }
+        --indexed;
+    }
+    uint64_t indexEnd = MAGIC_SIZE + indexed * sizeof(IndexEntry);
+    if (indexEnd != indexSize && !indexFile.Truncate(indexEnd)) {
+        throw std::runtime_error("Failed to repair index: " + std::to_string(indexEnd));
+    }
+
+    // Index the whole blocks written after it, then cut off a torn one
+    while (offset + sizeof(BlockHeader) <= dataOffset && dataFile.ReadAt(&entry.header, sizeof(BlockHeader), offset) &&
+           plausible(entry.header) && offset + sizeof(BlockHeader) + entry.header.storedBytes <= dataOffset) {
+        entry.offset = offset;
+        if (!indexFile.WriteAll(&entry, sizeof(entry))) {
+            std::cerr << "CompressedFileSink index write failed" << std::endl;
+        }
+        offset += sizeof(BlockHeader) + entry.header.storedBytes;
+    }
+    if (offset != dataOffset) {
+        std::cerr << "CompressedFileSink dropping " << dataOffset - offset << " torn bytes" << std::endl;
+        if (!dataFile.Truncate(offset)) {
+            throw std::runtime_error("Failed to repair data file at " + std::to_string(offset));
+        }
+        dataOffset = offset;
+    }
+}
+
+void CompressedFileSink::append(const LogMessage& log, std::unique_lock<std::mutex>& lock) {
+    int64_t ts = log.getTimestampNs();
+    if (current.records == 0) {
+        current.firstTimestampNs = ts;
+        current.lastTimestampNs = ts;
+        currentOpened = std::chrono::steady_clock::now();
+        if (config.flushInterval.count() > 0) {
+            blockReady.notify_one();    // Compressor times the new block's age
+        }
+    } else {
+        // Producers race, so the span is min/max rather than first/last seen
+        current.firstTimestampNs = std::min(current.firstTimestampNs, ts);
+        current.lastTimestampNs = std::max(current.lastTimestampNs, ts);
+    }
+    renderer.append(log, current.text);
+    ++current.records;
+
+    if (current.text.size() >= config.blockBytes) {
+        seal(lock);
+    }
+}
+
+bool CompressedFileSink::currentAged() const {
+    return current.records > 0 && config.flushInterval.count() > 0 &&
+        std::chrono::steady_clock::now() - currentOpened >= config.flushInterval;
+}
+
+void CompressedFileSink::seal(std::unique_lock<std::mutex>& lock) {
+    blockDone.wait(lock, [this] { return sealed.size() < config.maxPendingBlocks; });
+    sealed.push_back(takeCurrent());
+    blockReady.notify_one();
+}
+
+CompressedFileSink::Block CompressedFileSink::takeCurrent() {
+    Block block = std::move(current);
+    current = Block{};
+    if (!spareBuffers.empty()) {
+        current.text = std::move(spareBuffers.back());
+        spareBuffers.pop_back();
+        current.text.clear();
+    } else {
+        current.text.reserve(config.blockBytes + LogRenderer::MAX_LINE);
+    }
+    return block;
+}
+
+void CompressedFileSink::compressLoop() {
+    std::unique_lock<std::mutex> lock(mtx);
+    const bool aging = config.flushInterval.count() > 0;
+    while (true) {
+        // An idle caller never seals its partial block, so age it out here
+        if (aging && current.records > 0) {
+            blockReady.wait_until(lock, currentOpened + config.flushInterval,
+                                  [this] { return stopping || !sealed.empty() || currentAged(); });
+        } else {
+            blockReady.wait(lock, [this, aging] { return stopping || !sealed.empty() || (aging && current.records > 0); });
+        }
+
+        Block block;
+        if (!sealed.empty()) {
+            block = std::move(sealed.front());
+            sealed.pop_front();
+        } else if (stopping) {
+            return; // everything written
+        } else if (currentAged()) {
+            block = takeCurrent();
+        } else {
+            continue;
+        }
+        lock.unlock();
+
+        writeBlock(block);
+
+        lock.lock();
+        spareBuffers.push_back(std::move(block.text));
+        blockDone.notify_one();
+    }
+}
+
+void CompressedFileSink::writeBlock(const Block& block) {
+    BlockHeader header{};
+    header.rawBytes = static_cast<uint32_t>(block.text.size());
+    header.records = block.records;
+    header.firstTimestampNs = block.firstTimestampNs;
+    header.lastTimestampNs = block.lastTimestampNs;
+    header.codec = static_cast<uint8_t>(BlockCodec::STORED);
+
+    const char* payload = block.text.data();
+    size_t payloadSize = block.text.size();
+
+#ifdef TELELOG_HAVE_ZLIB
+    uLongf bound = compressBound(static_cast<uLong>(block.text.size()));
+    compressed.resize(bound);
+    int status = compress2(reinterpret_cast<Bytef*>(compressed.data()), &bound,
+                           reinterpret_cast<const Bytef*>(block.text.data()),
+                           static_cast<uLong>(block.text.size()), config.compressionLevel);
+    if (status == Z_OK && bound < block.text.size()) {
+        header.codec = static_cast<uint8_t>(BlockCodec::DEFLATE);
+        payload = compressed.data();
+        payloadSize = bound;
+    }
+#endif
+    header.storedBytes = static_cast<uint32_t>(payloadSize);
+
+    IndexEntry entry{};
+    entry.offset = dataOffset;
+    entry.header = header;
+
+    // Index after data: a torn index is repaired by BlockLogReader from the headers
+    if (!dataFile.WriteAll(&header, sizeof(header)) || !dataFile.WriteAll(payload, payloadSize)) {
+        std::cerr << "CompressedFileSink write failed, dropping " << block.records << " records" << std::endl;
+        // Cut a torn block off so the next one starts where the index and
+        // the header walk expect it; failing that, follow the real file end
+        if (!dataFile.Truncate(dataOffset)) {
+            dataFile.Size(dataOffset);
+        }
+        return;
+    }
+    dataOffset += sizeof(header) + payloadSize;
+    if (!indexFile.WriteAll(&entry, sizeof(entry))) {
+        std::cerr << "CompressedFileSink index write failed" << std::endl;
+    }
+
+    records.fetch_add(block.records, std::memory_order_relaxed);
+    blocks.fetch_add(1, std::memory_order_relaxed);
+    rawBytes.fetch_add(block.text.size(), std::memory_order_relaxed);
+    storedBytes.fetch_add(payloadSize, std::memory_order_relaxed);
+}
+
+void CompressedFileSink::write(const LogMessage& log) {
+    std::unique_lock<std::mutex> lock(mtx);
+    append(log, lock);
+    if (currentAged()) {
+        seal(lock);
+    }
+}
+
+void CompressedFileSink::writeBatch(const std::vector<LogMessage>& batch) {
+    std::unique_lock<std::mutex> lock(mtx);
+    for (const auto& log : batch) {
+        append(log, lock);
+    }
+    if (currentAged()) {
+        seal(lock);
+    }
+}
+
+CompressedFileSinkStats CompressedFileSink::getStats() const {
+    CompressedFileSinkStats stats;
+    stats.records = records.load(std::memory_order_relaxed);
+    stats.blocks = blocks.load(std::memory_order_relaxed);
+    stats.rawBytes = rawBytes.load(std::memory_order_relaxed);
+    stats.storedBytes = storedBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+CompressedFileSink::~CompressedFileSink() {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        if (current.records > 0) {
+            seal(lock);
+        }
+        stopping = true;
+        blockReady.notify_one();
+    }
+    if (compressor.joinable()) {
+        compressor.join();
+    }
+}
@@ -1,6 +1,24 @@
 #include "sink/ConsoleSinkImpl.hpp"
 #include <iostream>
 
+ConsoleSink::ConsoleSink(RenderOptions renderOptions) : renderer(renderOptions) {}
+
 void ConsoleSink::write(const LogMessage& log) {
-    std::cout << log << std::endl; 
-}
\ No newline at end of file
+    // Same renderer (and RenderOptions) as batches. No explicit flush:
+    // stdout is line buffered on a terminal, and piped output should not
+    // pay a flush per line
+    batchBuffer.clear();
+    renderer.append(log, batchBuffer);
+    std::cout.write(batchBuffer.data(), static_cast<std::streamsize>(batchBuffer.size()));
+}
+
+void ConsoleSink::writeBatch(const std::vector<LogMessage>& batch) {
+    // Render the whole batch first, then hand it to stdout in one write + flush
+    batchBuffer.clear();
+    for (const auto& log : batch) {
+        renderer.append(log, batchBuffer);
+    }
+
+    std::cout.write(batchBuffer.data(), static_cast<std::streamsize>(batchBuffer.size()));
+    std::cout.flush();
+}
@@ -1,14 +1,53 @@
 #include "sink/FileSinkImpl.hpp"
+#include "logger/TextIndexFormat.hpp"
+#include <sys/stat.h>
 #include <iostream>
 
-FileSink::FileSink(const std::string& filePath, std::ios::openmode mode) {
+FileSink::FileSink(const std::string& filePath, std::ios::openmode mode, RenderOptions renderOptions,
+                   TextIndexConfig indexConfig)
+    : renderer(renderOptions) {
     file.open(filePath, mode);
     if (!file.is_open()) {
         throw std::runtime_error("Failed to open file: " + filePath);
     }
+
+    if (indexConfig.enabled) {
+        // Checkpoints hold absolute offsets, so start from what is already there
+        struct stat info;
+        uint64_t size = stat(filePath.c_str(), &info) == 0 ? static_cast<uint64_t>(info.st_size) : 0;
+        index = std::make_unique<TextIndexWriter>(filePath + TextIndexFormat::INDEX_SUFFIX, size,
+                                                  (mode & std::ios::trunc) != 0,
+                                                  indexConfig.checkpointBytes, renderOptions);
+    }
+}
+
+void FileSink::append(const LogMessage& log) {
+    size_t before = batchBuffer.size();
+    renderer.append(log, batchBuffer);
+    if (index) {
+        index->record(log, batchBuffer.size() - before);
+    }
+}
+
+void FileSink::flushBuffer() {
+    file.write(batchBuffer.data(), static_cast<std::streamsize>(batchBuffer.size()));
+    file.flush();
+    if (index) {
+        index->flush();     // Only once the text it describes is written
+    }
 }
 
 void FileSink::write(const LogMessage& log){
-    file << log << std::endl;
+    batchBuffer.clear();
+    append(log);
+    flushBuffer();
 }
 
+void FileSink::writeBatch(const std::vector<LogMessage>& batch){
+    // One formatted buffer and a single flush per batch instead of per line
+    batchBuffer.clear();
+    for (const auto& log : batch) {
+        append(log);
+    }
+    flushBuffer();
+}
@@ -1,6 +1,10 @@
 #include "sink/LogSinkFactory.hpp"
 #include "sink/ConsoleSinkImpl.hpp"
 #include "sink/FileSinkImpl.hpp"
+#include "sink/MappedFileSinkImpl.hpp"
+#include "sink/BinarySinkImpl.hpp"
+#include "sink/SocketSinkImpl.hpp"
+#include "sink/CompressedFileSinkImpl.hpp"
 
 
 std::unique_ptr<ILogSink> LogSinkFactory::createSink(LogSinkType_enum type, 
@@ -13,6 +17,21 @@ std::unique_ptr<ILogSink> LogSinkFactory::createSink(LogSinkType_enum type,
             // Uses "system.log" if no path is provided
             return std::make_unique<FileSink>(filePath.empty() ? "system.log" : filePath);
 
+        case LogSinkType_enum::MAPPED_FILE:
+            // Segments are created as "<path>.<N>"
+            return std::make_unique<MappedFileSink>(filePath.empty() ? "system.log" : filePath);
+
+        case LogSinkType_enum::SOCKET:
+            // Connects lazily, so the collector may start after us
+            return std::make_unique<SocketSink>(filePath.empty() ? "/tmp/telelog.sock" : filePath);
+
+        case LogSinkType_enum::BINARY_FILE:
+            return std::make_unique<BinarySink>(filePath.empty() ? "system.tlog" : filePath);
+
+        case LogSinkType_enum::COMPRESSED_FILE:
+            // The block index is written next to it as "<path>.idx"
+            return std::make_unique<CompressedFileSink>(filePath.empty() ? "system.logz" : filePath);
+
         default:
             // If someone passes an invalid enum value
             return nullptr;
@@ -0,0 +1,216 @@
+#include "sink/MappedFileSinkImpl.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+    size_t pageSize() {
+        static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return size;
+    }
+}
+
+MappedFileSink::MappedFileSink(const std::string& basePath, MappedFileSinkConfig config)
+    : basePath(basePath), config(config), renderer(config.renderOptions), retryDelay(config.retryMin) {
+    // A segment must at least hold one full line
+    if (this->config.segmentBytes < 2 * LogRenderer::MAX_LINE) {
+        this->config.segmentBytes = 2 * LogRenderer::MAX_LINE;
+    }
+
+    // Continue after the last segment left by a previous run
+    struct stat info;
+    while (stat(currentSegmentPath().c_str(), &info) == 0) {
+        ++segmentIndex;
+    }
+
+    if (!openSegment()) {
+        throw std::runtime_error("Failed to map log segment: " + currentSegmentPath());
+    }
+}
+
+std::string MappedFileSink::currentSegmentPath() const {
+    return basePath + "." + std::to_string(segmentIndex);
+}
+
+bool MappedFileSink::openSegment() {
+    const std::string path = currentSegmentPath();
+    fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        return false;
+    }
+
+    // Reserve the blocks up front; fall back to a sparse file if unsupported
+    if (posix_fallocate(fd, 0, static_cast<off_t>(config.segmentBytes)) != 0 &&
+        ftruncate(fd, static_cast<off_t>(config.segmentBytes)) != 0) {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+
+    void* address = mmap(nullptr, config.segmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+
+    mapping = static_cast<char*>(address);
+    segments.fetch_add(1, std::memory_order_relaxed);
+    retryDelay = config.retryMin;
+    used = 0;
+    syncedUpTo = 0;
+    segmentOpened = std::chrono::steady_clock::now();
+    lastSync = segmentOpened;
+    return true;
+}
+
+void MappedFileSink::closeSegment() {
+    if (mapping != nullptr) {
+        if (config.syncPolicy != SyncPolicy_enum::NONE) {
+            sync();
+        }
+        munmap(mapping, config.segmentBytes);
+        mapping = nullptr;
+    }
+    if (fd != -1) {
+        // Drop the unused preallocated tail
+        if (ftruncate(fd, static_cast<off_t>(used)) != 0) {
+            std::cerr << "Failed to trim log segment: " << currentSegmentPath() << std::endl;
+        }
+        close(fd);
+        fd = -1;
+    }
+}
+
+bool MappedFileSink::rotate() {
+    closeSegment();
+    ++segmentIndex;
+    if (!openSegment()) {
+        std::cerr << "Failed to map log segment: " << currentSegmentPath() << std::endl;
+        failedOpens.fetch_add(1, std::memory_order_relaxed);
+        nextRetry = std::chrono::steady_clock::now() + retryDelay;
+        return false;
+    }
+    return true;
+}
+
+bool MappedFileSink::ensureMapped() {
+    if (mapping != nullptr) {
+        return true;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now < nextRetry) {
+        return false;
+    }
+    // Same segment index: the failed attempt left at most an empty file
+    if (openSegment()) {
+        return true;
+    }
+    failedOpens.fetch_add(1, std::memory_order_relaxed);
+    retryDelay = std::min(retryDelay * 2, config.retryMax);
+    nextRetry = now + retryDelay;
+    return false;
+}
+
+void MappedFileSink::sync() {
+    if (mapping == nullptr || used == syncedUpTo) {
+        return;
+    }
+    // msync needs a page-aligned start address
+    size_t start = syncedUpTo & ~(pageSize() - 1);
+    msync(mapping + start, used - start, MS_SYNC);
+    syncedUpTo = used;
+    lastSync = std::chrono::steady_clock::now();
+}
+
+void MappedFileSink::append(const LogMessage& log) {
+    if (!ensureMapped()) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    size_t remaining = config.segmentBytes - used;
+    size_t bound = LogRenderer::maxLineLength(log);
+    if (remaining > bound) {
+        // Enough room for any rendering of it: render straight into the mapping
+        size_t written = renderer.render(log, mapping + used, bound);
+        mapping[used + written] = '\n';
+        used += written + 1;
+        return;
+    }
+
+    line.clear();
+    renderer.append(log, line);
+    if (line.size() > remaining) {
+        if (line.size() > config.segmentBytes || !rotate()) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    std::memcpy(mapping + used, line.data(), line.size());
+    used += line.size();
+}
+
+void MappedFileSink::applySyncPolicy(bool sawError) {
+    switch (config.syncPolicy) {
+        case SyncPolicy_enum::INTERVAL:
+            if (std::chrono::steady_clock::now() - lastSync >= config.syncInterval) {
+                sync();
+            }
+            break;
+        case SyncPolicy_enum::BYTES:
+            if (used - syncedUpTo >= config.syncBytes) {
+                sync();
+            }
+            break;
+        case SyncPolicy_enum::ON_ERROR:
+            if (sawError) {
+                sync();
+            }
+            break;
+        case SyncPolicy_enum::NONE:
+        default:
+            break;
+    }
+}
+
+void MappedFileSink::rotateIfExpired() {
+    if (config.rotateInterval.count() > 0 && mapping != nullptr && used > 0 &&
+        std::chrono::steady_clock::now() - segmentOpened >= config.rotateInterval) {
+        rotate();
+    }
+}
+
+void MappedFileSink::write(const LogMessage& log) {
+    rotateIfExpired();
+    append(log);
+    applySyncPolicy(log.getSeverity() == LogType::ERROR);
+}
+
+void MappedFileSink::writeBatch(const std::vector<LogMessage>& batch) {
+    rotateIfExpired();
+
+    bool sawError = false;
+    for (const auto& log : batch) {
+        append(log);
+        sawError = sawError || log.getSeverity() == LogType::ERROR;
+    }
+    applySyncPolicy(sawError);
+}
+
+MappedFileSinkStats MappedFileSink::getStats() const {
+    MappedFileSinkStats stats;
+    stats.segments = segments.load(std::memory_order_relaxed);
+    stats.failedOpens = failedOpens.load(std::memory_order_relaxed);
+    stats.dropped = dropped.load(std::memory_order_relaxed);
+    return stats;
+}
+
+MappedFileSink::~MappedFileSink() {
+    closeSegment();
+}
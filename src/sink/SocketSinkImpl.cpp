@@ -0,0 +1,159 @@
+#include "sink/SocketSinkImpl.hpp"
+#include <sys/uio.h>
+#include <algorithm>
+#include <cerrno>
+
+SocketSink::SocketSink(const std::string& socketPath, SocketSinkConfig config)
+    : path(socketPath), config(config), renderer(config.renderOptions),
+      nextAttempt(std::chrono::steady_clock::now()), backoff(config.reconnectMin) {
+    tryConnect();
+}
+
+void SocketSink::tryConnect() {
+    auto now = std::chrono::steady_clock::now();
+    if (now < nextAttempt) {
+        return;
+    }
+
+    auto candidate = std::make_unique<SafeSocket>(SafeSocket::ConnectNonBlocking(path));
+    if (!candidate->IsOpen()) {
+        connectFailures.fetch_add(1, std::memory_order_relaxed);
+        nextAttempt = now + backoff;
+        backoff = std::min(backoff * 2, config.reconnectMax);
+        return;
+    }
+
+    socket = std::move(candidate);
+    if (everConnected) {
+        reconnects.fetch_add(1, std::memory_order_relaxed);
+    }
+    everConnected = true;
+    backoff = config.reconnectMin;
+    connected.store(true, std::memory_order_relaxed);
+}
+
+void SocketSink::disconnect() {
+    socket.reset();
+    connected.store(false, std::memory_order_relaxed);
+    nextAttempt = std::chrono::steady_clock::now() + backoff;
+    // A line cut in half would corrupt the stream of the next connection
+    dropPartialRecord();
+}
+
+void SocketSink::dropPartialRecord() {
+    if (pendingOffset == 0 || pendingOffset >= pending.size() || pending[pendingOffset - 1] == '\n') {
+        return;
+    }
+    size_t end = pending.find('\n', pendingOffset);
+    pendingOffset = end == std::string::npos ? pending.size() : end + 1;
+    recordsDropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SocketSink::trimPending() {
+    size_t unsent = pending.size() - pendingOffset;
+    if (unsent > config.retryBufferBytes) {
+        // Never cut into a line that is already partly on the wire
+        size_t from = pendingOffset;
+        if (from > 0 && pending[from - 1] != '\n') {
+            size_t end = pending.find('\n', from);
+            from = end == std::string::npos ? pending.size() : end + 1;
+        }
+
+        size_t target = from + (unsent - config.retryBufferBytes);
+        size_t cut = target > 0 ? pending.find('\n', target - 1) : 0;
+        cut = cut == std::string::npos ? pending.size() : cut + 1;
+        if (cut > from) {
+            uint64_t lines = static_cast<uint64_t>(std::count(pending.begin() + from, pending.begin() + cut, '\n'));
+            recordsDropped.fetch_add(lines, std::memory_order_relaxed);
+            pending.erase(from, cut - from);
+        }
+    }
+
+    // Reclaim the sent prefix once it dominates the buffer
+    if (pendingOffset > 0 && pendingOffset * 2 >= pending.size()) {
+        pending.erase(0, pendingOffset);
+        pendingOffset = 0;
+    }
+    bufferedBytes.store(pending.size() - pendingOffset, std::memory_order_relaxed);
+}
+
+void SocketSink::ship() {
+    if (!socket) {
+        tryConnect();
+    }
+
+    size_t batchSent = 0;
+    while (socket) {
+        size_t pendingLeft = pending.size() - pendingOffset;
+        size_t batchLeft = batchBuffer.size() - batchSent;
+        if (pendingLeft == 0 && batchLeft == 0) {
+            break;
+        }
+
+        struct iovec buffers[2];
+        int count = 0;
+        if (pendingLeft > 0) {
+            buffers[count].iov_base = pending.data() + pendingOffset;
+            buffers[count].iov_len = pendingLeft;
+            ++count;
+        }
+        if (batchLeft > 0) {
+            buffers[count].iov_base = batchBuffer.data() + batchSent;
+            buffers[count].iov_len = batchLeft;
+            ++count;
+        }
+
+        ssize_t sent = socket->SendV(buffers, count);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;  // Peer is slow: keep the rest for the next batch
+            }
+            // Keep the unsent lines for the next connection, minus any cut one
+            if (batchSent > 0 && batchBuffer[batchSent - 1] != '\n') {
+                size_t end = batchBuffer.find('\n', batchSent);
+                batchSent = end == std::string::npos ? batchBuffer.size() : end + 1;
+                recordsDropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            pending.append(batchBuffer, batchSent, std::string::npos);
+            batchSent = batchBuffer.size();
+            disconnect();
+            break;
+        }
+
+        size_t progress = static_cast<size_t>(sent);
+        bytesSent.fetch_add(progress, std::memory_order_relaxed);
+        size_t fromPending = std::min(progress, pendingLeft);
+        pendingOffset += fromPending;
+        batchSent += progress - fromPending;
+    }
+
+    if (batchSent < batchBuffer.size()) {
+        pending.append(batchBuffer, batchSent, std::string::npos);
+    }
+    trimPending();
+}
+
+void SocketSink::write(const LogMessage& log) {
+    batchBuffer.clear();
+    renderer.append(log, batchBuffer);
+    ship();
+}
+
+void SocketSink::writeBatch(const std::vector<LogMessage>& batch) {
+    batchBuffer.clear();
+    for (const auto& log : batch) {
+        renderer.append(log, batchBuffer);
+    }
+    ship();
+}
+
+SocketSinkStats SocketSink::getStats() const {
+    SocketSinkStats stats;
+    stats.bytesSent = bytesSent.load(std::memory_order_relaxed);
+    stats.recordsDropped = recordsDropped.load(std::memory_order_relaxed);
+    stats.reconnects = reconnects.load(std::memory_order_relaxed);
+    stats.connectFailures = connectFailures.load(std::memory_order_relaxed);
+    stats.bufferedBytes = bufferedBytes.load(std::memory_order_relaxed);
+    stats.connected = connected.load(std::memory_order_relaxed);
+    return stats;
+}
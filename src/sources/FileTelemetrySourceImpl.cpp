@@ -19,9 +19,18 @@ bool FileTelemetrySourceImpl::openSource() {
 }
 
 bool FileTelemetrySourceImpl::readSource(std::string& out) {
-    if (filePtr && filePtr->IsOpen()) {
-        out = filePtr->Read();
+    std::string_view line;
+    if (filePtr && filePtr->IsOpen() && filePtr->ReadLine(line)) {
+        out.assign(line.data(), line.size());
         return true;
     }
+    return false; // Source isn't open or has no more data
+}
+
+bool FileTelemetrySourceImpl::readSourceBatch(std::vector<std::string_view>& out) {
+    if (filePtr && filePtr->IsOpen()) {
+        return filePtr->ReadLines(out);
+    }
+    out.clear();
     return false; // Could not read because source isn't open
 }
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include "sources/IngestionEngine.hpp"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cerrno>
+#include <iostream>
+
+namespace {
+    constexpr int MAX_EVENTS = 64;
+    constexpr int IDLE_TIMEOUT_MS = 100;
+}
+
+IngestionEngine::IngestionEngine(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        auto loop = std::make_unique<Loop>();
+        loop->epollFd = epoll_create1(EPOLL_CLOEXEC);
+        loop->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;   // nullptr marks the wake-up descriptor
+        epoll_ctl(loop->epollFd, EPOLL_CTL_ADD, loop->wakeFd, &event);
+        loops.push_back(std::move(loop));
+    }
+}
+
+IngestionEngine::~IngestionEngine() {
+    stop();
+    for (auto& loop : loops) {
+        loop->sources.clear();
+        close(loop->wakeFd);
+        close(loop->epollFd);
+    }
+}
+
+bool IngestionEngine::registerSource(std::unique_ptr<Source> source, Loop* loop) {
+    if (loop == nullptr) {
+        loop = loops[nextLoop.fetch_add(1, std::memory_order_relaxed) % loops.size()].get();
+    }
+
+    Source* raw = source.get();
+    std::lock_guard<std::mutex> lock(loop->mtx);
+    loop->sources.emplace(raw, std::move(source));
+
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.ptr = raw;
+    if (epoll_ctl(loop->epollFd, EPOLL_CTL_ADD, raw->fd, &event) == -1) {
+        if (errno == EPERM && raw->kind == SourceKind::FILE) {
+            loop->polled.push_back(raw); // Regular file: always readable, drained in chunks
+        } else {
+            loop->sources.erase(raw);
+            return false;
+        }
+    }
+    activeSources.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool IngestionEngine::addSocket(const std::string& path, LineHandler handler) {
+    auto source = std::make_unique<Source>();
+    source->kind = SourceKind::SOCKET;
+    source->socket = std::make_unique<SafeSocket>(path);
+    if (!source->socket->IsOpen() || !source->socket->SetNonBlocking()) {
+        return false;
+    }
+    source->fd = source->socket->GetFd();
+    source->handler = std::make_shared<LineHandler>(std::move(handler));
+    return registerSource(std::move(source));
+}
+
+bool IngestionEngine::addFile(const std::string& path, LineHandler handler) {
+    auto source = std::make_unique<Source>();
+    source->kind = SourceKind::FILE;
+    source->file = std::make_unique<SafeFile>(path);
+    if (!source->file->IsOpen() || !source->file->SetNonBlocking()) {
+        return false;
+    }
+    source->fd = source->file->GetFd();
+    source->handler = std::make_shared<LineHandler>(std::move(handler));
+    return registerSource(std::move(source));
+}
+
+bool IngestionEngine::listen(const std::string& path, LineHandler handler) {
+    auto source = std::make_unique<Source>();
+    source->kind = SourceKind::LISTENER;
+    source->socket = std::make_unique<SafeSocket>(SafeSocket::Listen(path));
+    if (!source->socket->IsOpen() || !source->socket->SetNonBlocking()) {
+        return false;
+    }
+    source->fd = source->socket->GetFd();
+    source->handler = std::make_shared<LineHandler>(std::move(handler));
+    return registerSource(std::move(source));
+}
+
+void IngestionEngine::acceptAll(Source& listener) {
+    while (true) {
+        auto peer = std::make_unique<SafeSocket>(listener.socket->Accept());
+        if (!peer->IsOpen()) {
+            return; // EAGAIN: backlog drained
+        }
+        if (!peer->SetNonBlocking()) {
+            continue;
+        }
+
+        auto source = std::make_unique<Source>();
+        source->kind = SourceKind::SOCKET;
+        source->fd = peer->GetFd();
+        source->socket = std::move(peer);
+        source->handler = listener.handler;
+        if (registerSource(std::move(source))) {
+            connectionsAccepted.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool IngestionEngine::drain(Source& source, std::vector<std::string_view>& lines) {
+    bool gotLines = source.socket ? source.socket->ReadLines(lines) : source.file->ReadLines(lines);
+    if (gotLines) {
+        linesRead.fetch_add(lines.size(), std::memory_order_relaxed);
+        for (std::string_view line : lines) {
+            (*source.handler)(line);
+        }
+    }
+    uint64_t dropped = source.socket ? source.socket->DroppedLines() : source.file->DroppedLines();
+    if (dropped != source.droppedLines) {
+        linesTooLong.fetch_add(dropped - source.droppedLines, std::memory_order_relaxed);
+        source.droppedLines = dropped;
+    }
+    bool atEof = source.socket ? source.socket->AtEof() : source.file->AtEof();
+    return !atEof;
+}
+
+void IngestionEngine::closeSource(Loop& loop, Source* source) {
+    epoll_ctl(loop.epollFd, EPOLL_CTL_DEL, source->fd, nullptr);
+
+    std::lock_guard<std::mutex> lock(loop.mtx);
+    for (auto it = loop.polled.begin(); it != loop.polled.end(); ++it) {
+        if (*it == source) {
+            loop.polled.erase(it);
+            break;
+        }
+    }
+    loop.sources.erase(source);   // SafeSocket/SafeFile close the descriptor
+    activeSources.fetch_sub(1, std::memory_order_relaxed);
+    sourcesClosed.fetch_add(1, std::memory_order_relaxed);
+}
+
+void IngestionEngine::run(Loop& loop) {
+    epoll_event events[MAX_EVENTS];
+    std::vector<std::string_view> lines;
+    std::vector<Source*> polled;
+
+    while (running.load(std::memory_order_acquire)) {
+        {
+            std::lock_guard<std::mutex> lock(loop.mtx);
+            polled = loop.polled;
+        }
+        int timeout = polled.empty() ? IDLE_TIMEOUT_MS : 0;
+
+        int count = epoll_wait(loop.epollFd, events, MAX_EVENTS, timeout);
+        if (count == -1 && errno != EINTR) {
+            std::cerr << "epoll_wait failed, stopping ingestion loop" << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            Source* source = static_cast<Source*>(events[i].data.ptr);
+            if (source == nullptr) {
+                uint64_t value;
+                while (read(loop.wakeFd, &value, sizeof(value)) > 0) {
+                }
+                continue;
+            }
+
+            if (source->kind == SourceKind::LISTENER) {
+                acceptAll(*source);
+                continue;
+            }
+
+            // Read what is there first so a peer's last lines survive a hang-up
+            bool open = drain(*source, lines);
+            if (!open || (events[i].events & EPOLLERR)) {
+                closeSource(loop, source);
+            }
+        }
+
+        for (Source* source : polled) {
+            if (!drain(*source, lines)) {
+                closeSource(loop, source);
+            }
+        }
+    }
+}
+
+void IngestionEngine::start() {
+    if (running.exchange(true)) {
+        return;
+    }
+    for (auto& loop : loops) {
+        Loop* raw = loop.get();
+        raw->thread = std::thread([this, raw] { run(*raw); });
+    }
+}
+
+void IngestionEngine::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    for (auto& loop : loops) {
+        uint64_t one = 1;
+        if (write(loop->wakeFd, &one, sizeof(one)) < 0) {
+            // The loop still notices running == false within IDLE_TIMEOUT_MS
+        }
+    }
+    for (auto& loop : loops) {
+        if (loop->thread.joinable()) {
+            loop->thread.join();
+        }
+    }
+}
+
+IngestionStats IngestionEngine::getStats() const {
+    IngestionStats stats;
+    stats.linesRead = linesRead.load(std::memory_order_relaxed);
+    stats.linesRejected = linesRejected.load(std::memory_order_relaxed);
+    stats.linesFiltered = linesFiltered.load(std::memory_order_relaxed);
+    stats.linesTooLong = linesTooLong.load(std::memory_order_relaxed);
+    stats.connectionsAccepted = connectionsAccepted.load(std::memory_order_relaxed);
+    stats.sourcesClosed = sourcesClosed.load(std::memory_order_relaxed);
+    int64_t active = activeSources.load(std::memory_order_relaxed);
+    stats.activeSources = active > 0 ? static_cast<size_t>(active) : 0;
+    return stats;
+}
@@ -0,0 +1,65 @@
+#include "sources/MemInfoCollectorImpl.hpp"
+#include <charconv>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+
+namespace {
+    // "Key:    12345 kB" -> 12345
+    bool parseKb(std::string_view line, std::string_view key, uint64_t& value) {
+        if (line.size() <= key.size() || line.compare(0, key.size(), key) != 0) {
+            return false;
+        }
+        const char* pos = line.data() + key.size();
+        const char* end = line.data() + line.size();
+        while (pos < end && *pos == ' ') {
+            ++pos;
+        }
+        return std::from_chars(pos, end, value).ec == std::errc();
+    }
+}
+
+MemInfoCollectorImpl::MemInfoCollectorImpl(LogManager& manager, const std::string& app, const std::string& path)
+    : manager(manager), path(path), formatter(app, "RAM_USAGE") {
+    formatter.bindFilter(manager.getSeverityFilter());
+}
+
+bool MemInfoCollectorImpl::open() {
+    file = std::make_unique<SafeFile>(path);
+    if (!file->IsOpen()) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+    buffer.resize(8 * 1024);
+    return true;
+}
+
+bool MemInfoCollectorImpl::collect(std::chrono::system_clock::time_point now) {
+    std::string_view content;
+    if (!file || !file->Snapshot(buffer, content)) {
+        return false;
+    }
+
+    uint64_t total = 0;
+    uint64_t available = 0;
+    bool haveTotal = false;
+    bool haveAvailable = false;
+    while (!content.empty() && !(haveTotal && haveAvailable)) {
+        size_t newline = content.find('\n');
+        std::string_view line = content.substr(0, newline);
+        content.remove_prefix(newline == std::string_view::npos ? content.size() : newline + 1);
+
+        haveTotal = haveTotal || parseKb(line, "MemTotal:", total);
+        haveAvailable = haveAvailable || parseKb(line, "MemAvailable:", available);
+    }
+    if (!haveTotal || !haveAvailable || total == 0 || available > total) {
+        return false;
+    }
+
+    float usage = 100.0f * static_cast<float>(total - available) / static_cast<float>(total);
+    LogMessage message;
+    if (formatter.tryFormatValue(usage, message, now) == FormatStatus_enum::ACCEPTED) {
+        manager.addLog(std::move(message));
+    }
+    return true;
+}
@@ -0,0 +1,118 @@
+#include "sources/ProcStatCollectorImpl.hpp"
+#include <charconv>
+#include <iostream>
+
+namespace {
+    // user nice system idle iowait irq softirq steal; guest time is already in user
+    constexpr size_t ACCOUNTED_FIELDS = 8;
+    constexpr size_t IDLE = 3;
+    constexpr size_t IOWAIT = 4;
+}
+
+ProcStatCollectorImpl::ProcStatCollectorImpl(LogManager& manager, const std::string& app, bool perCore,
+                                             const std::string& path)
+    : manager(manager), app(app), path(path), perCore(perCore), totalFormatter(app, "CPU_LOAD") {
+    totalFormatter.bindFilter(manager.getSeverityFilter());
+}
+
+bool ProcStatCollectorImpl::open() {
+    file = std::make_unique<SafeFile>(path);
+    if (!file->IsOpen()) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+    buffer.resize(16 * 1024);
+    return true;
+}
+
+bool ProcStatCollectorImpl::parseTimes(std::string_view fields, CpuTimes& times) {
+    const char* pos = fields.data();
+    const char* end = pos + fields.size();
+    uint64_t idle = 0;
+    times.total = 0;
+    for (size_t i = 0; i < ACCOUNTED_FIELDS; ++i) {
+        while (pos < end && *pos == ' ') {
+            ++pos;
+        }
+        uint64_t value = 0;
+        auto result = std::from_chars(pos, end, value);
+        if (result.ec != std::errc()) {
+            if (i <= IOWAIT) {
+                return false; // Kernels since 2.6 have at least these
+            }
+            break;
+        }
+        pos = result.ptr;
+        times.total += value;
+        if (i == IDLE || i == IOWAIT) {
+            idle += value;
+        }
+    }
+    times.busy = times.total - idle;
+    times.valid = true;
+    return true;
+}
+
+void ProcStatCollectorImpl::report(const LogFormatter<CpuPolicy>& formatter, CpuTimes& previous,
+                                   const CpuTimes& current, std::chrono::system_clock::time_point now) {
+    if (!previous.valid || current.total < previous.total || current.busy < previous.busy) {
+        previous = current; // First sample, or the core went offline and came back
+        return;
+    }
+    uint64_t elapsed = current.total - previous.total;
+    if (elapsed == 0) {
+        return;
+    }
+    float usage = 100.0f * static_cast<float>(current.busy - previous.busy) / static_cast<float>(elapsed);
+    previous = current;
+
+    LogMessage message;
+    if (formatter.tryFormatValue(usage, message, now) == FormatStatus_enum::ACCEPTED) {
+        manager.addLog(std::move(message));
+    }
+}
+
+bool ProcStatCollectorImpl::collect(std::chrono::system_clock::time_point now) {
+    std::string_view content;
+    if (!file || !file->Snapshot(buffer, content)) {
+        return false;
+    }
+
+    bool sawTotal = false;
+    while (!content.empty()) {
+        size_t newline = content.find('\n');
+        std::string_view line = content.substr(0, newline);
+        content.remove_prefix(newline == std::string_view::npos ? content.size() : newline + 1);
+
+        if (line.size() < 4 || line.compare(0, 3, "cpu") != 0) {
+            break; // The cpu lines come first; skip intr, ctxt, softirq...
+        }
+
+        CpuTimes current;
+        if (line[3] == ' ') {
+            if (parseTimes(line.substr(4), current)) {
+                report(totalFormatter, totalPrevious, current, now);
+                sawTotal = true;
+            }
+            continue;
+        }
+        if (!perCore) {
+            break;
+        }
+
+        size_t core = 0;
+        auto result = std::from_chars(line.data() + 3, line.data() + line.size(), core);
+        if (result.ec != std::errc() ||
+            !parseTimes(line.substr(static_cast<size_t>(result.ptr - line.data())), current)) {
+            continue;
+        }
+        // Only allocates the first time a core shows up
+        while (coreFormatters.size() <= core) {
+            coreFormatters.emplace_back(app, "CPU_CORE_" + std::to_string(coreFormatters.size()));
+            coreFormatters.back().bindFilter(manager.getSeverityFilter());
+            corePrevious.emplace_back();
+        }
+        report(coreFormatters[core], corePrevious[core], current, now);
+    }
+    return sawTotal;
+}
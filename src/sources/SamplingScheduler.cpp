@@ -0,0 +1,198 @@
+#include "sources/SamplingScheduler.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free,
+                  "The futex word must be a plain 32-bit integer");
+
+    uint32_t* futexWord(std::atomic<uint32_t>& word) {
+        return reinterpret_cast<uint32_t*>(&word);
+    }
+
+    // Sleeps until deadline (steady_clock is CLOCK_MONOTONIC) unless word
+    // moves on from seen; true once the deadline has passed
+    bool sleepUntil(std::atomic<uint32_t>& word, uint32_t seen, std::chrono::steady_clock::time_point deadline) {
+        auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch());
+        timespec at{};
+        at.tv_sec = static_cast<time_t>(sinceEpoch.count() / 1'000'000'000);
+        at.tv_nsec = static_cast<long>(sinceEpoch.count() % 1'000'000'000);
+        while (word.load(std::memory_order_acquire) == seen) {
+            long rc = syscall(SYS_futex, futexWord(word), FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG, seen, &at,
+                              nullptr, FUTEX_BITSET_MATCH_ANY);
+            if (rc != 0 && errno == ETIMEDOUT) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+SamplingScheduler::SamplingScheduler(std::chrono::milliseconds tick)
+    : tick(std::max(tick, std::chrono::milliseconds(1))), wheel(WHEEL_SLOTS),
+      cursorTime(std::chrono::steady_clock::now()) {}
+
+SamplingScheduler::~SamplingScheduler() {
+    stop();
+}
+
+void SamplingScheduler::arm(const Timer& timer, uint64_t delayTicks) {
+    Timer armed = timer;
+    armed.rounds = (delayTicks - 1) / WHEEL_SLOTS;
+    size_t slot = (cursor + delayTicks) % WHEEL_SLOTS;
+    wheel[slot].push_back(armed);
+    occupied[slot / WORD_BITS] |= uint64_t{1} << (slot % WORD_BITS);
+}
+
+void SamplingScheduler::armAdded() {
+    std::lock_guard<std::mutex> lock(mtx);
+    // The thread may have slept past cursorTime; count from now
+    auto now = std::chrono::steady_clock::now();
+    uint64_t behind = now > cursorTime ? static_cast<uint64_t>((now - cursorTime) / tick) : 0;
+    for (const Timer& timer : added) {
+        arm(timer, timer.intervalTicks + behind);
+    }
+    added.clear();
+    pendingAdds.store(false, std::memory_order_relaxed);
+}
+
+size_t SamplingScheduler::ticksToNextTimer() const {
+    for (size_t step = 1; step <= WHEEL_SLOTS;) {
+        size_t slot = (cursor + step) % WHEEL_SLOTS;
+        uint64_t bits = occupied[slot / WORD_BITS] >> (slot % WORD_BITS);
+        if (bits != 0) {
+            // Bits past the cursor's own slot belong to the next turn
+            return std::min(step + static_cast<size_t>(__builtin_ctzll(bits)), WHEEL_SLOTS);
+        }
+        step += WORD_BITS - slot % WORD_BITS;
+    }
+    return WHEEL_SLOTS;
+}
+
+bool SamplingScheduler::add(std::unique_ptr<ITelemetryCollector> collector, std::chrono::milliseconds interval) {
+    if (!collector || !collector->open()) {
+        return false;
+    }
+    uint64_t ticks = std::max<uint64_t>(1, static_cast<uint64_t>(interval / tick));
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        added.push_back(Timer{collector.get(), ticks, 0});
+        collectors.push_back(std::move(collector));
+        pendingAdds.store(true, std::memory_order_relaxed);
+    }
+    wake();
+    return true;
+}
+
+void SamplingScheduler::wake() {
+    signal.fetch_add(1, std::memory_order_release);
+    syscall(SYS_futex, futexWord(signal), FUTEX_WAKE | FUTEX_PRIVATE_FLAG, 1, nullptr, nullptr, 0);
+}
+
+void SamplingScheduler::run() {
+    while (true) {
+        // Read before the checks below, so a later add() or stop() ends the sleep
+        uint32_t seen = signal.load(std::memory_order_acquire);
+        if (stopping.load(std::memory_order_acquire)) {
+            break;
+        }
+        if (pendingAdds.load(std::memory_order_acquire)) {
+            armAdded();
+        }
+
+        size_t steps = ticksToNextTimer();
+        auto deadline = cursorTime + steps * tick;
+        if (!sleepUntil(signal, seen, deadline)) {
+            continue; // Stop, or a new timer may be due before the old deadline
+        }
+
+        cursor = (cursor + steps) % WHEEL_SLOTS;
+        cursorTime = deadline;
+
+        // Slots skipped on the way were empty, so only this one needs a pass
+        auto& slot = wheel[cursor];
+        due.clear();
+        for (size_t i = 0; i < slot.size();) {
+            if (slot[i].rounds > 0) {
+                --slot[i].rounds;
+                ++i;
+            } else {
+                due.push_back(slot[i]);
+                slot[i] = slot.back();
+                slot.pop_back();
+            }
+        }
+        if (slot.empty()) {
+            occupied[cursor / WORD_BITS] &= ~(uint64_t{1} << (cursor % WORD_BITS));
+        }
+
+        // One wall-clock reading for every collector due on this tick
+        auto sampledAt = std::chrono::system_clock::now();
+        auto start = std::chrono::steady_clock::now();
+        auto end = start;
+        for (const Timer& timer : due) {
+            bool ok = timer.collector->collect(sampledAt);
+            end = std::chrono::steady_clock::now();
+            collectNs.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()),
+                                std::memory_order_relaxed);
+            start = end;
+            samples.fetch_add(1, std::memory_order_relaxed);
+            if (!ok) {
+                failures.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        for (const Timer& timer : due) {
+            arm(timer, timer.intervalTicks);
+        }
+
+        if (end >= cursorTime + tick) {
+            overruns.fetch_add(1, std::memory_order_relaxed);
+            // Far behind (suspend, debugger): resume from now instead of replaying every tick
+            if (end - cursorTime > WHEEL_SLOTS * tick) {
+                cursorTime = end;
+            }
+        }
+    }
+}
+
+void SamplingScheduler::start() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (running) {
+        return;
+    }
+    running = true;
+    stopping.store(false, std::memory_order_relaxed);
+    cursorTime = std::chrono::steady_clock::now();
+    thread = std::thread(&SamplingScheduler::run, this);
+}
+
+void SamplingScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!running) {
+            return;
+        }
+    }
+    stopping.store(true, std::memory_order_release);
+    wake();
+    thread.join();
+    std::lock_guard<std::mutex> lock(mtx);
+    running = false;
+}
+
+SamplingStats SamplingScheduler::getStats() const {
+    SamplingStats stats;
+    stats.samples = samples.load(std::memory_order_relaxed);
+    stats.failures = failures.load(std::memory_order_relaxed);
+    stats.overruns = overruns.load(std::memory_order_relaxed);
+    stats.collectNs = collectNs.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mtx);
+    stats.collectors = collectors.size();
+    return stats;
+}
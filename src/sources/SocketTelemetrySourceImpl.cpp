@@ -15,9 +15,18 @@ bool SocketTelemetrySourceImpl::openSource() {
 }
 
 bool SocketTelemetrySourceImpl::readSource(std::string& out) {
-    if (socketPtr && socketPtr->IsOpen()) {
-        out = socketPtr->Read();
+    std::string_view line;
+    if (socketPtr && socketPtr->IsOpen() && socketPtr->ReadLine(line)) {
+        out.assign(line.data(), line.size());
         return true;
     }
+    return false; // Source isn't open or has no more data
+}
+
+bool SocketTelemetrySourceImpl::readSourceBatch(std::vector<std::string_view>& out) {
+    if (socketPtr && socketPtr->IsOpen()) {
+        return socketPtr->ReadLines(out);
+    }
+    out.clear();
     return false; // Could not read because source isn't open
 }
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "logger/BlockLogReader.hpp"
+#include "ToolArgs.hpp"
+
+// Prints the text of a CompressedFileSink file, decompressing only the
+// blocks whose indexed time span overlaps the requested range.
+//
+//   TeleLogCat <file> [--from TIME] [--to TIME] [--utc] [--list]
+//
+// TIME is either epoch seconds or "YYYY-MM-DD HH:MM:SS"; --utc must match the
+// sink's RenderOptions so line timestamps compare correctly. Lines of blocks
+// that straddle a bound are filtered by their timestamp (second precision).
+// --list prints the block index instead of the text.
+
+namespace {
+    void usage() {
+        std::cerr << "usage: TeleLogCat <file> [--from TIME] [--to TIME] [--utc] [--list]\n";
+    }
+
+    void listBlocks(const BlockLogReader& reader) {
+        std::cout << "offset,records,raw_bytes,stored_bytes,codec,first_ns,last_ns\n";
+        for (const auto& entry : reader.blocks()) {
+            const auto& header = entry.header;
+            std::cout << entry.offset << ',' << header.records << ',' << header.rawBytes << ','
+                      << header.storedBytes << ','
+                      << (header.codec == static_cast<uint8_t>(BlockLogFormat::BlockCodec::DEFLATE) ? "deflate" : "stored")
+                      << ',' << header.firstTimestampNs << ',' << header.lastTimestampNs << '\n';
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+
+    std::string path = argv[1];
+    std::string fromText, toText;
+    bool utc = false;
+    bool list = false;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--from" && hasValue) {
+            fromText = argv[++i];
+        } else if (arg == "--to" && hasValue) {
+            toText = argv[++i];
+        } else if (arg == "--utc") {
+            utc = true;
+        } else if (arg == "--list") {
+            list = true;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    int64_t fromNs = INT64_MIN;
+    int64_t toNs = INT64_MAX;
+    if (!fromText.empty()) {
+        auto parsed = parseTime(fromText, utc);
+        if (!parsed) {
+            usage();
+            return 1;
+        }
+        fromNs = *parsed;
+    }
+    if (!toText.empty()) {
+        auto parsed = parseTime(toText, utc);
+        if (!parsed) {
+            usage();
+            return 1;
+        }
+        toNs = *parsed;
+    }
+
+    BlockLogReader reader(path);
+    if (!reader.isValid()) {
+        std::cerr << "Not a TeleLog block file: " << path << std::endl;
+        return 1;
+    }
+    if (reader.recoveredBlocks() > 0) {
+        std::cerr << "Recovered " << reader.recoveredBlocks() << " blocks missing from the index" << std::endl;
+    }
+    if (list) {
+        listBlocks(reader);
+        return 0;
+    }
+
+    const int64_t fromSecond = fromNs == INT64_MIN ? INT64_MIN : fromNs / 1'000'000'000;
+    const int64_t toSecond = toNs == INT64_MAX ? INT64_MAX : toNs / 1'000'000'000;
+    LineClock clock{utc, {}, 0};
+    std::string text;
+    size_t failed = 0;
+
+    for (size_t index : reader.overlapping(fromNs, toNs)) {
+        const auto& entry = reader.blocks()[index];
+        if (!reader.readBlock(entry, text)) {
+            ++failed;
+            continue;
+        }
+
+        // Whole block inside the range: no per-line work
+        if (entry.header.firstTimestampNs >= fromNs && entry.header.lastTimestampNs <= toNs) {
+            std::cout.write(text.data(), static_cast<std::streamsize>(text.size()));
+            continue;
+        }
+
+        std::string_view rest(text);
+        while (!rest.empty()) {
+            size_t newline = rest.find('\n');
+            size_t length = newline == std::string_view::npos ? rest.size() : newline + 1;
+            std::string_view line = rest.substr(0, length);
+            rest.remove_prefix(length);
+
+            int64_t second;
+            if (clock.secondOf(line, second) && second >= fromSecond && second <= toSecond) {
+                std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+            }
+        }
+    }
+
+    if (failed > 0) {
+        std::cerr << "Skipped " << failed << " unreadable blocks" << std::endl;
+    }
+    return 0;
+}
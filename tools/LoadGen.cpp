@@ -0,0 +1,685 @@
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "logger/LogManager.hpp"
+#include "formatter/LogFormatter.hpp"
+#include "formatter/policies/CpuPolicy.hpp"
+#include "formatter/policies/RamPolicy.hpp"
+#include "formatter/policies/GpuPolicy.hpp"
+#include "sink/LogSinkFactory.hpp"
+#include "sources/SocketTelemetrySourceImpl.hpp"
+#include "raii/SafeSocket.hpp"
+#include "ToolArgs.hpp"
+
+// Drives a LogManager with recorded or synthetic CPU/RAM/GPU telemetry at a
+// configured rate and reports what the configuration sustained.
+//
+//   TeleLogLoadGen [--replay FILE] [--rate N] [--mode fixed|bursty|max] [--burst N]
+//                  [--producers N] [--feeders M] [--duration SEC]
+//                  [--sink null|console|file:PATH|binary:PATH|mapped:PATH|compressed:PATH|socket:PATH]...
+//                  [--async] [--capacity N] [--batch N]
+//                  [--overflow drop-newest|drop-oldest|block|spin-block|shed]
+//                  [--shm PATH] [--sweep FROM:TO:STEP] [--csv]
+//
+// Producers call LogFormatter + addLog directly; feeders write lines into a
+// Unix socket read by a SocketTelemetrySourceImpl thread that formats and
+// queues them. --rate is the total for all senders (0 with --mode max).
+// Paced messages carry their scheduled send time, so end-to-end latency
+// includes any time a saturated sender fell behind; for feeders it starts
+// when the reader parses the line. --replay reads one reading per line,
+// optionally prefixed with "cpu ", "ram " or "gpu "; unprefixed lines rotate
+// over the three series. --sweep repeats the run for each rate and marks the
+// first one the configuration could not sustain.
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    enum class Pacing { FIXED, BURSTY, MAX };
+    enum class Series : uint8_t { CPU, RAM, GPU };
+
+    struct Reading {
+        Series series;
+        float value;
+        std::string text;       // As sent by feeders
+    };
+
+    struct Options {
+        std::string replayPath;
+        double rate = 100'000.0;
+        Pacing pacing = Pacing::FIXED;
+        size_t burst = 1000;
+        size_t producers = 1;
+        size_t feeders = 0;
+        double duration = 5.0;
+        std::vector<std::string> sinks;
+        bool async = false;
+        size_t capacity = 65536;
+        size_t maxBatch = 256;
+        OverflowPolicy_enum overflow = OverflowPolicy_enum::DROP_NEWEST;
+        std::string sharedQueuePath;
+        double sweepFrom = 0.0;
+        double sweepTo = 0.0;
+        double sweepStep = 0.0;
+        bool csv = false;
+    };
+
+    struct RunResult {
+        double offeredRate = 0.0;       // Target, 0 for max
+        double sentRate = 0.0;          // What the senders managed to offer
+        double sustainedRate = 0.0;     // Delivered to the sinks per second
+        uint64_t sent = 0;
+        uint64_t delivered = 0;
+        uint64_t dropped = 0;           // Queue overflow plus ASYNC sink drops
+        uint64_t rejected = 0;          // Lines the formatter could not parse
+        uint64_t maxLagUs = 0;          // Furthest a sender fell behind schedule
+        HistogramSnapshot endToEnd;     // First sink
+        HistogramSnapshot enqueue;
+    };
+
+    class NullSink : public ILogSink {
+    public:
+        void write(const LogMessage&) override {}
+        void writeBatch(const std::vector<LogMessage>&) override {}
+    };
+
+    void usage() {
+        std::cerr << "usage: TeleLogLoadGen [--replay FILE] [--rate N] [--mode fixed|bursty|max] [--burst N]\n"
+                     "                      [--producers N] [--feeders M] [--duration SEC]\n"
+                     "                      [--sink null|console|file:PATH|binary:PATH|mapped:PATH|compressed:PATH|socket:PATH]...\n"
+                     "                      [--async] [--capacity N] [--batch N]\n"
+                     "                      [--overflow drop-newest|drop-oldest|block|spin-block|shed]\n"
+                     "                      [--shm PATH] [--sweep FROM:TO:STEP] [--csv]\n";
+    }
+
+    // Checks a --sink value without opening or connecting anything
+    bool validSinkSpec(const std::string& spec) {
+        size_t colon = spec.find(':');
+        std::string kind = spec.substr(0, colon);
+        if (kind == "null" || kind == "console") {
+            return colon == std::string::npos;
+        }
+        bool hasPath = colon != std::string::npos && colon + 1 < spec.size();
+        return hasPath && (kind == "file" || kind == "binary" || kind == "mapped" ||
+                           kind == "compressed" || kind == "socket");
+    }
+
+    std::unique_ptr<ILogSink> makeSink(const std::string& spec) {
+        size_t colon = spec.find(':');
+        std::string kind = spec.substr(0, colon);
+        std::string path = colon == std::string::npos ? "" : spec.substr(colon + 1);
+        if (kind == "null")       return std::make_unique<NullSink>();
+        if (kind == "console")    return LogSinkFactory::createSink(LogSinkType_enum::CONSOLE);
+        if (kind == "file")       return LogSinkFactory::createSink(LogSinkType_enum::FILE, path);
+        if (kind == "binary")     return LogSinkFactory::createSink(LogSinkType_enum::BINARY_FILE, path);
+        if (kind == "mapped")     return LogSinkFactory::createSink(LogSinkType_enum::MAPPED_FILE, path);
+        if (kind == "compressed") return LogSinkFactory::createSink(LogSinkType_enum::COMPRESSED_FILE, path);
+        if (kind == "socket")     return LogSinkFactory::createSink(LogSinkType_enum::SOCKET, path);
+        return nullptr;
+    }
+
+    std::optional<OverflowPolicy_enum> parseOverflow(const std::string& text) {
+        if (text == "drop-newest") return OverflowPolicy_enum::DROP_NEWEST;
+        if (text == "drop-oldest") return OverflowPolicy_enum::DROP_OLDEST;
+        if (text == "block")       return OverflowPolicy_enum::BLOCK_WITH_TIMEOUT;
+        if (text == "spin-block")  return OverflowPolicy_enum::SPIN_THEN_BLOCK;
+        if (text == "shed")        return OverflowPolicy_enum::DROP_BELOW_SEVERITY;
+        return std::nullopt;
+    }
+
+    // "cpu 42.5" or "42.5"; the bare form takes the series of its line number
+    bool parseRecorded(std::string_view line, size_t lineNumber, Reading& out) {
+        out.series = static_cast<Series>(lineNumber % 3);
+        if (line.size() > 4 && line[3] == ' ') {
+            std::string_view prefix = line.substr(0, 3);
+            if (prefix == "cpu" || prefix == "ram" || prefix == "gpu") {
+                out.series = prefix == "cpu" ? Series::CPU : prefix == "ram" ? Series::RAM : Series::GPU;
+                line.remove_prefix(4);
+            }
+        }
+        out.text.assign(line);
+        return parseReading(line, out.value);
+    }
+
+    bool loadRecorded(const std::string& path, std::vector<Reading>& readings, uint64_t& invalid) {
+        std::ifstream in(path);
+        if (!in) {
+            return false;
+        }
+        std::string line;
+        size_t lineNumber = 0;
+        while (std::getline(in, line)) {
+            Reading reading;
+            if (parseRecorded(line, lineNumber++, reading)) {
+                readings.push_back(std::move(reading));
+            } else {
+                ++invalid;
+            }
+        }
+        return !readings.empty();
+    }
+
+    // Random walk per series with rare spikes, so every severity shows up
+    void synthesize(std::vector<Reading>& readings, size_t count) {
+        std::mt19937 rng(42);
+        std::normal_distribution<float> step(0.0f, 2.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        float levels[3] = {35.0f, 55.0f, 20.0f};
+        char text[32];
+        for (size_t i = 0; i < count; ++i) {
+            size_t series = i % 3;
+            levels[series] = std::clamp(levels[series] + step(rng), 0.0f, 100.0f);
+            float value = unit(rng) < 0.01f ? 85.0f + 15.0f * unit(rng) : levels[series];
+            int length = std::snprintf(text, sizeof(text), "%.2f", value);
+            readings.push_back({static_cast<Series>(series), value, std::string(text, static_cast<size_t>(length))});
+        }
+    }
+
+    struct Formatters {
+        LogFormatter<CpuPolicy> cpu{"LoadGen", "CPU_LOAD"};
+        LogFormatter<RamPolicy> ram{"LoadGen", "RAM_USAGE"};
+        LogFormatter<GpuPolicy> gpu{"LoadGen", "GPU_LOAD"};
+
+        FormatStatus_enum format(Series series, float value, LogMessage& out,
+                                 std::chrono::system_clock::time_point timestamp) const {
+            switch (series) {
+                case Series::CPU: return cpu.tryFormatValue(value, out, timestamp);
+                case Series::RAM: return ram.tryFormatValue(value, out, timestamp);
+                default:          return gpu.tryFormatValue(value, out, timestamp);
+            }
+        }
+
+        FormatStatus_enum format(Series series, std::string_view line, LogMessage& out) const {
+            switch (series) {
+                case Series::CPU: return cpu.tryFormat(line, out);
+                case Series::RAM: return ram.tryFormat(line, out);
+                default:          return gpu.tryFormat(line, out);
+            }
+        }
+    };
+
+    // Due time of message i for one sender offering rate msg/s
+    class Schedule {
+    private:
+        Pacing pacing;
+        double interval;        // Seconds between messages (fixed) or bursts (bursty)
+        size_t burst;
+        Clock::time_point start;
+
+    public:
+        Schedule(Pacing pacing, double rate, size_t burst, Clock::time_point start)
+            : pacing(rate > 0 ? pacing : Pacing::MAX),
+              interval(rate > 0 ? (pacing == Pacing::BURSTY ? burst / rate : 1.0 / rate) : 0.0),
+              burst(std::max<size_t>(burst, 1)), start(start) {}
+
+        bool paced() const { return pacing != Pacing::MAX; }
+
+        Clock::time_point due(uint64_t i) const {
+            double slot = pacing == Pacing::BURSTY ? static_cast<double>(i / burst) : static_cast<double>(i);
+            return start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(slot * interval));
+        }
+    };
+
+    // Sleeps for the bulk of the wait, then spins the last stretch
+    void waitUntil(Clock::time_point due) {
+        constexpr auto SPIN = std::chrono::microseconds(100);
+        auto now = Clock::now();
+        if (due - now > SPIN) {
+            std::this_thread::sleep_until(due - SPIN);
+        }
+        while (Clock::now() < due) {
+            std::this_thread::yield();
+        }
+    }
+
+    struct Shared {
+        const Options& options;
+        const std::vector<Reading>& readings;
+        const Formatters& formatters;
+        LogManager& manager;
+        Clock::time_point start;
+        Clock::time_point stop;
+        std::chrono::system_clock::time_point systemStart;
+        std::atomic<uint64_t> sent{0};
+        std::atomic<uint64_t> queued{0};    // addLog calls
+        std::atomic<uint64_t> rejected{0};
+        std::atomic<uint64_t> maxLagNs{0};
+
+        void noteLag(Clock::duration lag) {
+            uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(lag).count());
+            uint64_t seen = maxLagNs.load(std::memory_order_relaxed);
+            while (ns > seen && !maxLagNs.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+            }
+        }
+    };
+
+    void runProducer(Shared& shared, size_t index, double rate) {
+        Schedule schedule(shared.options.pacing, rate, shared.options.burst, shared.start);
+        const auto& readings = shared.readings;
+        size_t cursor = index * readings.size() / std::max<size_t>(shared.options.producers, 1);
+        uint64_t sent = 0, queued = 0, rejected = 0;
+        Clock::duration maxLag{0};
+
+        for (uint64_t i = 0;; ++i) {
+            auto now = Clock::now();
+            auto due = schedule.paced() ? schedule.due(i) : now;
+            if (due >= shared.stop || now >= shared.stop) {
+                break;
+            }
+            if (due > now) {
+                waitUntil(due);
+            } else {
+                maxLag = std::max(maxLag, now - due);
+            }
+
+            const Reading& reading = readings[cursor];
+            cursor = cursor + 1 == readings.size() ? 0 : cursor + 1;
+            LogMessage msg;
+            FormatStatus_enum status = shared.formatters.format(
+                reading.series, reading.value, msg,
+                shared.systemStart + std::chrono::duration_cast<std::chrono::system_clock::duration>(due - shared.start));
+            ++sent;
+            if (status == FormatStatus_enum::ACCEPTED) {
+                shared.manager.addLog(std::move(msg));
+                ++queued;
+            } else if (status == FormatStatus_enum::REJECTED) {
+                ++rejected;
+            }
+        }
+        shared.sent.fetch_add(sent, std::memory_order_relaxed);
+        shared.queued.fetch_add(queued, std::memory_order_relaxed);
+        shared.rejected.fetch_add(rejected, std::memory_order_relaxed);
+        shared.noteLag(maxLag);
+    }
+
+    // Writes every line that is due in one sendmsg, blocking when the reader lags
+    void runFeeder(Shared& shared, SafeSocket& peer, size_t index, double rate) {
+        Schedule schedule(shared.options.pacing, rate, shared.options.burst, shared.start);
+        const auto& readings = shared.readings;
+        size_t cursor = index * readings.size() / std::max<size_t>(shared.options.feeders, 1);
+        std::string pending;
+        uint64_t sent = 0;
+        Clock::duration maxLag{0};
+        constexpr size_t MAX_CHUNK = 64 * 1024;
+
+        for (uint64_t i = 0;;) {
+            auto now = Clock::now();
+            auto due = schedule.paced() ? schedule.due(i) : now;
+            if (due >= shared.stop || now >= shared.stop) {
+                break;
+            }
+            if (due > now) {
+                waitUntil(due);
+                now = Clock::now();
+            } else {
+                maxLag = std::max(maxLag, now - due);
+            }
+
+            pending.clear();
+            while (pending.size() < MAX_CHUNK && (!schedule.paced() || schedule.due(i) <= now)) {
+                const Reading& reading = readings[cursor];
+                cursor = cursor + 1 == readings.size() ? 0 : cursor + 1;
+                pending += reading.text;
+                pending += '\n';
+                ++i;
+                if (!schedule.paced() && pending.size() >= MAX_CHUNK / 4) {
+                    break;
+                }
+            }
+
+            size_t offset = 0;
+            while (offset < pending.size()) {
+                iovec buffer{pending.data() + offset, pending.size() - offset};
+                ssize_t written = peer.SendV(&buffer, 1);
+                if (written <= 0) {
+                    shared.sent.fetch_add(sent, std::memory_order_relaxed);
+                    return;
+                }
+                offset += static_cast<size_t>(written);
+            }
+            sent = i;
+        }
+        shared.sent.fetch_add(sent, std::memory_order_relaxed);
+        shared.noteLag(maxLag);
+    }
+
+    // The SocketTelemetrySourceImpl side of a feeder; series follow the
+    // reading order the feeder used, so the cursor is replayed here
+    void runReader(Shared& shared, const std::string& path, size_t index) {
+        SocketTelemetrySourceImpl source(path);
+        if (!source.openSource()) {
+            std::cerr << "Feeder " << index << ": cannot connect to " << path << std::endl;
+            return;
+        }
+        const auto& readings = shared.readings;
+        size_t cursor = index * readings.size() / std::max<size_t>(shared.options.feeders, 1);
+        std::vector<std::string_view> lines;
+        uint64_t queued = 0, rejected = 0;
+
+        while (source.readSourceBatch(lines)) {
+            for (std::string_view line : lines) {
+                Series series = readings[cursor].series;
+                cursor = cursor + 1 == readings.size() ? 0 : cursor + 1;
+                LogMessage msg;
+                FormatStatus_enum status = shared.formatters.format(series, line, msg);
+                if (status == FormatStatus_enum::ACCEPTED) {
+                    shared.manager.addLog(std::move(msg));
+                    ++queued;
+                } else if (status == FormatStatus_enum::REJECTED) {
+                    ++rejected;
+                }
+            }
+        }
+        shared.queued.fetch_add(queued, std::memory_order_relaxed);
+        shared.rejected.fetch_add(rejected, std::memory_order_relaxed);
+    }
+
+    uint64_t sinkDrops(const LogManager& manager) {
+        uint64_t dropped = 0;
+        for (const SinkLagStats& lag : manager.getSinkLagStats()) {
+            dropped += lag.droppedMessages;
+        }
+        return dropped;
+    }
+
+    // Waits until every queued message was drained and reached (or was
+    // dropped by) the first sink, whose latencies are reported
+    void awaitDrain(const LogManager& manager, uint64_t queued, bool async) {
+        auto deadline = Clock::now() + std::chrono::seconds(30);
+        while (Clock::now() < deadline) {
+            LogManagerMetrics metrics = manager.getMetrics();
+            uint64_t delivered = metrics.sinks.front().endToEnd.count;
+            uint64_t lost = async ? manager.getSinkLagStats().front().droppedMessages : 0;
+            if (metrics.messages + metrics.overflow.totalDropped() >= queued && delivered + lost >= metrics.messages) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::cerr << "Sinks still busy after 30 s, reporting what was delivered" << std::endl;
+    }
+
+    RunResult runOnce(const Options& options, const std::vector<Reading>& readings, double rate) {
+        LogManagerConfig config;
+        config.capacity = options.capacity;
+        config.maxBatch = options.maxBatch;
+        config.overflow.policy = options.overflow;
+        config.sinkDispatch = options.async ? SinkDispatch_enum::ASYNC : SinkDispatch_enum::INLINE;
+        config.sharedQueuePath = options.sharedQueuePath;
+
+        RunResult result;
+        result.offeredRate = options.pacing == Pacing::MAX ? 0.0 : rate;
+        LogManager manager(config);
+        for (const std::string& spec : options.sinks) {
+            manager.addSink(makeSink(spec));
+        }
+        Formatters formatters;
+
+        // Sockets are connected before the clock starts
+        const size_t senders = options.producers + options.feeders;
+        const double perSender = result.offeredRate / static_cast<double>(std::max<size_t>(senders, 1));
+        std::vector<std::string> paths;
+        std::vector<SafeSocket> listeners, peers;
+        std::vector<std::thread> readers, threads;
+        Shared shared{options, readings, formatters, manager, {}, {}, {}};
+
+        for (size_t m = 0; m < options.feeders; ++m) {
+            paths.push_back("/tmp/telelog_loadgen." + std::to_string(getpid()) + "." + std::to_string(m) + ".sock");
+            listeners.push_back(SafeSocket::Listen(paths.back()));
+            if (!listeners.back().IsOpen()) {
+                throw std::runtime_error("Cannot listen on " + paths.back());
+            }
+        }
+        for (size_t m = 0; m < options.feeders; ++m) {
+            readers.emplace_back(runReader, std::ref(shared), paths[m], m);
+            peers.push_back(listeners[m].Accept());
+        }
+
+        shared.start = Clock::now();
+        shared.systemStart = std::chrono::system_clock::now();
+        shared.stop = shared.start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.duration));
+        for (size_t p = 0; p < options.producers; ++p) {
+            threads.emplace_back(runProducer, std::ref(shared), p, perSender);
+        }
+        for (size_t m = 0; m < options.feeders; ++m) {
+            threads.emplace_back(runFeeder, std::ref(shared), std::ref(peers[m]), m, perSender);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        double sendSeconds = std::chrono::duration<double>(Clock::now() - shared.start).count();
+
+        peers.clear();      // EOF ends the readers
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        for (const std::string& path : paths) {
+            unlink(path.c_str());
+        }
+        awaitDrain(manager, shared.queued.load(), options.async);
+        double totalSeconds = std::chrono::duration<double>(Clock::now() - shared.start).count();
+
+        LogManagerMetrics metrics = manager.getMetrics();
+        result.sent = shared.sent.load();
+        result.delivered = metrics.sinks.front().endToEnd.count;
+        result.dropped = metrics.overflow.totalDropped() + sinkDrops(manager);
+        result.rejected = shared.rejected.load();
+        result.maxLagUs = shared.maxLagNs.load() / 1000;
+        result.sentRate = result.sent / sendSeconds;
+        result.sustainedRate = result.delivered / totalSeconds;
+        result.endToEnd = metrics.sinks.front().endToEnd;
+        result.enqueue = metrics.enqueueLatency;
+        return result;
+    }
+
+    // Dropped anything, or delivered or offered clearly less than asked for
+    bool saturated(const RunResult& result) {
+        constexpr double KEEP_UP = 0.97;
+        return result.dropped > 0 ||
+               (result.offeredRate > 0 && (result.sentRate < KEEP_UP * result.offeredRate ||
+                                           result.sustainedRate < KEEP_UP * result.offeredRate));
+    }
+
+    void printHeader(bool csv) {
+        if (csv) {
+            std::cout << "target_rate,sent_rate,sustained_rate,sent,delivered,dropped,rejected,"
+                         "max_lag_us,e2e_p50_us,e2e_p90_us,e2e_p99_us,e2e_p999_us,e2e_max_us,"
+                         "enqueue_p99_ns,saturated\n";
+        }
+    }
+
+    void printResult(const RunResult& result, bool csv) {
+        const HistogramSnapshot& e2e = result.endToEnd;
+        if (csv) {
+            std::cout << result.offeredRate << ',' << result.sentRate << ',' << result.sustainedRate << ','
+                      << result.sent << ',' << result.delivered << ',' << result.dropped << ','
+                      << result.rejected << ',' << result.maxLagUs << ',' << e2e.p50Ns / 1000.0 << ','
+                      << e2e.p90Ns / 1000.0 << ',' << e2e.p99Ns / 1000.0 << ',' << e2e.p999Ns / 1000.0 << ','
+                      << e2e.maxNs / 1000.0 << ',' << result.enqueue.p99Ns << ','
+                      << (saturated(result) ? "yes" : "no") << '\n';
+            return;
+        }
+        std::cout << "target     " << (result.offeredRate > 0 ? std::to_string(static_cast<uint64_t>(result.offeredRate)) + " msg/s" : "max") << '\n'
+                  << "offered    " << static_cast<uint64_t>(result.sentRate) << " msg/s (" << result.sent
+                  << " sent, sender lag max " << result.maxLagUs << " us)\n"
+                  << "sustained  " << static_cast<uint64_t>(result.sustainedRate) << " msg/s ("
+                  << result.delivered << " delivered)\n"
+                  << "dropped    " << result.dropped << ", rejected " << result.rejected << '\n'
+                  << "e2e        p50 " << e2e.p50Ns / 1000.0 << " us, p90 " << e2e.p90Ns / 1000.0
+                  << " us, p99 " << e2e.p99Ns / 1000.0 << " us, p99.9 " << e2e.p999Ns / 1000.0
+                  << " us, max " << e2e.maxNs / 1000.0 << " us\n"
+                  << "addLog     p50 " << result.enqueue.p50Ns << " ns, p99 " << result.enqueue.p99Ns << " ns\n"
+                  << "saturated  " << (saturated(result) ? "yes" : "no") << "\n\n";
+    }
+
+    bool parseSweep(const std::string& text, Options& options) {
+        return std::sscanf(text.c_str(), "%lf:%lf:%lf", &options.sweepFrom, &options.sweepTo, &options.sweepStep) == 3 &&
+               options.sweepFrom > 0 && options.sweepStep > 0 && options.sweepTo >= options.sweepFrom;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--replay" && hasValue) {
+            options.replayPath = argv[++i];
+        } else if (arg == "--rate" && hasValue) {
+            auto value = parseNumber(argv[++i]);
+            if (!value) {
+                usage();
+                return 1;
+            }
+            options.rate = *value;
+        } else if (arg == "--mode" && hasValue) {
+            std::string mode = argv[++i];
+            if (mode == "fixed") {
+                options.pacing = Pacing::FIXED;
+            } else if (mode == "bursty") {
+                options.pacing = Pacing::BURSTY;
+            } else if (mode == "max") {
+                options.pacing = Pacing::MAX;
+            } else {
+                usage();
+                return 1;
+            }
+        } else if (arg == "--burst" && hasValue) {
+            auto value = parseCount(argv[++i]);
+            if (!value) {
+                usage();
+                return 1;
+            }
+            options.burst = *value;
+        } else if (arg == "--producers" && hasValue) {
+            auto value = parseCount(argv[++i]);
+            if (!value) {
+                usage();
+                return 1;
+            }
+            options.producers = *value;
+        } else if (arg == "--feeders" && hasValue) {
+            auto value = parseCount(argv[++i]);
+            if (!value) {
+                usage();
+                return 1;
+            }
+            options.feeders = *value;
+        } else if (arg == "--duration" && hasValue) {
+            auto value = parseNumber(argv[++i]);
+            if (!value) {
+                usage();
+                return 1;
+            }
+            options.duration = *value;
+        } else if (arg == "--sink" && hasValue) {
+            options.sinks.push_back(argv[++i]);
+            if (!validSinkSpec(options.sinks.back())) {
+                usage();
+                return 1;
+            }
+        } else if (arg == "--async") {
+            options.async = true;
+        } else if (arg == "--capacity" && hasValue) {
+            auto value = parseCount(argv[++i]);
+            if (!value) {
+                usage();
+                return 1;
+            }
+            options.capacity = *value;
+        } else if (arg == "--batch" && hasValue) {
+            auto value = parseCount(argv[++i]);
+            if (!value) {
+                usage();
+                return 1;
+            }
+            options.maxBatch = *value;
+        } else if (arg == "--overflow" && hasValue) {
+            auto policy = parseOverflow(argv[++i]);
+            if (!policy) {
+                usage();
+                return 1;
+            }
+            options.overflow = *policy;
+        } else if (arg == "--shm" && hasValue) {
+            options.sharedQueuePath = argv[++i];
+        } else if (arg == "--sweep" && hasValue) {
+            if (!parseSweep(argv[++i], options)) {
+                usage();
+                return 1;
+            }
+        } else if (arg == "--csv") {
+            options.csv = true;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if (options.producers + options.feeders == 0 || options.duration <= 0) {
+        usage();
+        return 1;
+    }
+    if (options.sinks.empty()) {
+        options.sinks.push_back("null");
+    }
+
+    std::vector<Reading> readings;
+    uint64_t invalid = 0;
+    if (!options.replayPath.empty()) {
+        if (!loadRecorded(options.replayPath, readings, invalid)) {
+            std::cerr << "No readings in " << options.replayPath << std::endl;
+            return 1;
+        }
+        if (invalid > 0) {
+            std::cerr << "Skipped " << invalid << " unparsable lines in " << options.replayPath << std::endl;
+        }
+    } else {
+        synthesize(readings, 300'000);
+    }
+
+    // Sinks are created per run; a path that cannot be opened ends up here
+    try {
+        std::cout << std::fixed << std::setprecision(1);
+        printHeader(options.csv);
+        if (options.sweepStep > 0) {
+            if (options.pacing == Pacing::MAX) {
+                options.pacing = Pacing::FIXED;
+            }
+            std::optional<double> limit;
+            for (double rate = options.sweepFrom; rate <= options.sweepTo; rate += options.sweepStep) {
+                RunResult result = runOnce(options, readings, rate);
+                printResult(result, options.csv);
+                if (saturated(result)) {
+                    limit = rate;
+                    break;
+                }
+            }
+            if (!options.csv) {
+                std::cout << (limit ? "saturates at " + std::to_string(static_cast<uint64_t>(*limit)) + " msg/s"
+                                    : "no saturation up to " + std::to_string(static_cast<uint64_t>(options.sweepTo)) + " msg/s")
+                          << '\n';
+            }
+            return 0;
+        }
+
+        printResult(runOnce(options, readings, options.pacing == Pacing::MAX ? 0.0 : options.rate), options.csv);
+        return 0;
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+}
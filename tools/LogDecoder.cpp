@@ -0,0 +1,107 @@
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+#include <optional>
+
+#include "logger/BinaryLogReader.hpp"
+#include "logger/LogRenderer.hpp"
+#include "ToolArgs.hpp"
+
+// Decodes a BinarySink file back into the text layout of operator<<.
+//
+//   TeleLogDecode <file> [--from TIME] [--to TIME] [--min-severity INFO|WARNING|ERROR]
+//                        [--utc] [--subsec 0|3|6|9]
+//
+// TIME is either epoch seconds or "YYYY-MM-DD HH:MM:SS" (local time, or UTC with --utc).
+
+namespace {
+    void usage() {
+        std::cerr << "usage: TeleLogDecode <file> [--from TIME] [--to TIME] "
+                     "[--min-severity INFO|WARNING|ERROR] [--utc] [--subsec 0|3|6|9]\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+
+    std::string path = argv[1];
+    std::string fromText, toText;
+    LogType minSeverity = LogType::INFO;
+    RenderOptions options;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--from" && hasValue) {
+            fromText = argv[++i];
+        } else if (arg == "--to" && hasValue) {
+            toText = argv[++i];
+        } else if (arg == "--min-severity" && hasValue) {
+            auto severity = parseSeverity(argv[++i]);
+            if (!severity) {
+                usage();
+                return 1;
+            }
+            minSeverity = *severity;
+        } else if (arg == "--subsec" && hasValue) {
+            options.subSecondDigits = std::atoi(argv[++i]);
+        } else if (arg == "--utc") {
+            options.utc = true;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    // Times are parsed after all flags so --utc applies regardless of order
+    int64_t fromNs = INT64_MIN;
+    int64_t toNs = INT64_MAX;
+    if (!fromText.empty()) {
+        auto parsed = parseTime(fromText, options.utc);
+        if (!parsed) {
+            usage();
+            return 1;
+        }
+        fromNs = *parsed;
+    }
+    if (!toText.empty()) {
+        auto parsed = parseTime(toText, options.utc);
+        if (!parsed) {
+            usage();
+            return 1;
+        }
+        toNs = *parsed;
+    }
+
+    BinaryLogReader reader(path);
+    if (!reader.isValid()) {
+        std::cerr << "Not a TeleLog binary file: " << path << std::endl;
+        return 1;
+    }
+
+    LogRenderer renderer(options);
+    std::string out;
+    LogMessage msg;
+    while (reader.next(msg)) {
+        if (msg.getSeverity() < minSeverity ||
+            msg.getTimestampNs() < fromNs || msg.getTimestampNs() > toNs) {
+            continue;
+        }
+        renderer.append(msg, out);
+        if (out.size() >= 64 * 1024) {
+            std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+            out.clear();
+        }
+    }
+    std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+
+    if (reader.skippedRecords() > 0) {
+        std::cerr << "Skipped " << reader.skippedRecords() << " malformed records" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "logger/SharedQueueFile.hpp"
+#include "logger/LogRenderer.hpp"
+
+// Post-mortem extraction from a LogManager shared queue file
+// (LogManagerConfig::sharedQueuePath, or the "<path>.crash[.N]" copy kept by
+// the next run): prints every committed record the crashed process had not
+// delivered yet, oldest first, in the text layout of FileSink.
+//
+//   TeleLogRecover <file> [--utc] [--subsec 0|3|6|9] [--info]
+//
+// --info only reports the header and the number of recoverable records.
+
+namespace {
+    void usage() {
+        std::cerr << "usage: TeleLogRecover <file> [--utc] [--subsec 0|3|6|9] [--info]\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+
+    std::string path = argv[1];
+    RenderOptions options;
+    bool infoOnly = false;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--subsec" && i + 1 < argc) {
+            options.subSecondDigits = std::atoi(argv[++i]);
+        } else if (arg == "--utc") {
+            options.utc = true;
+        } else if (arg == "--info") {
+            infoOnly = true;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    std::vector<LogMessage> records;
+    SharedQueueRecovery recovery = SharedQueueFile::recover(path, records);
+    if (!recovery.valid) {
+        std::cerr << "Not a TeleLog shared queue of this build: " << path << std::endl;
+        return 1;
+    }
+
+    std::cerr << path << ": owner pid " << recovery.ownerPid << ", capacity " << recovery.capacity << ", "
+              << (recovery.cleanShutdown ? "closed cleanly" : "not closed cleanly") << ", "
+              << recovery.committed << " undelivered records" << std::endl;
+    if (infoOnly) {
+        return 0;
+    }
+
+    LogRenderer renderer(options);
+    std::string text;
+    for (const LogMessage& record : records) {
+        renderer.append(record, text);
+    }
+    std::cout.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return 0;
+}
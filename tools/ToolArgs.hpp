@@ -0,0 +1,84 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "logger/LogMessage.hpp"
+
+// Command-line values shared by the tools.
+
+// Time: epoch seconds or "YYYY-MM-DD HH:MM:SS" (local time, or UTC when utc
+// is set). Returns ns.
+inline std::optional<int64_t> parseTime(const std::string& text, bool utc) {
+    char* end = nullptr;
+    long long seconds = std::strtoll(text.c_str(), &end, 10);
+    if (end != text.c_str() && *end == '\0') {
+        return static_cast<int64_t>(seconds) * 1'000'000'000;
+    }
+
+    std::tm tm{};
+    const char* rest = strptime(text.c_str(), "%Y-%m-%d %H:%M:%S", &tm);
+    if (rest == nullptr) {
+        return std::nullopt;
+    }
+    tm.tm_isdst = -1;
+    std::time_t t = utc ? timegm(&tm) : std::mktime(&tm);
+    return static_cast<int64_t>(t) * 1'000'000'000;
+}
+
+// Whole-string numbers; nullopt instead of an exception on bad input
+inline std::optional<size_t> parseCount(const std::string& text) {
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long value = std::strtoull(text.c_str(), &end, 10);
+    if (text.empty() || text[0] == '-' || end == text.c_str() || *end != '\0' || errno == ERANGE) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(value);
+}
+
+inline std::optional<double> parseNumber(const std::string& text) {
+    char* end = nullptr;
+    errno = 0;
+    double value = std::strtod(text.c_str(), &end);
+    if (end == text.c_str() || *end != '\0' || errno == ERANGE) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+inline std::optional<LogType> parseSeverity(const std::string& text) {
+    if (text == "INFO")    return LogType::INFO;
+    if (text == "WARNING") return LogType::WARNING;
+    if (text == "ERROR")   return LogType::ERROR;
+    return std::nullopt;
+}
+
+// Seconds of a rendered line's "YYYY-MM-DD HH:MM:SS" prefix, cached per distinct prefix
+struct LineClock {
+    bool utc;
+    std::string lastPrefix;
+    int64_t lastSecond = 0;
+
+    bool secondOf(std::string_view line, int64_t& second) {
+        constexpr size_t PREFIX = 19;
+        if (line.size() < PREFIX) {
+            return false;
+        }
+        std::string_view prefix = line.substr(0, PREFIX);
+        if (prefix != lastPrefix) {
+            auto parsed = parseTime(std::string(prefix), utc);
+            if (!parsed) {
+                return false;
+            }
+            lastPrefix.assign(prefix);
+            lastSecond = *parsed / 1'000'000'000;
+        }
+        second = lastSecond;
+        return true;
+    }
+};